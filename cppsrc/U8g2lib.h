@@ -77,6 +77,11 @@ class U8G2
     void setBusClock(uint32_t clock_speed) { u8g2_GetU8x8(&u8g2)->bus_clock = clock_speed; }
 
     void setI2CAddress(uint8_t adr) { u8g2_SetI2CAddress(&u8g2, adr); }
+
+#ifdef U8X8_WITH_TRANSFER_BUFFER
+    /* call this before begin() */
+    void setTransferBuffer(uint8_t *buf, uint8_t size) { u8g2_SetTransferBuffer(&u8g2, buf, size); }
+#endif
     
     
     void enableUTF8Print(void) { cpp_next_cb = u8x8_utf8_next; }
@@ -137,6 +142,10 @@ class U8G2
       
     void setDisplayRotation(const u8g2_cb_t *u8g2_cb) {
       u8g2_SetDisplayRotation(&u8g2, u8g2_cb); }
+#ifdef U8G2_WITH_FLUSH_ROTATION
+    uint8_t setFlushRotation(const u8g2_cb_t *u8g2_cb) {
+      return u8g2_SetFlushRotation(&u8g2, u8g2_cb); }
+#endif
       
     
 
@@ -189,6 +198,9 @@ class U8G2
     
     void firstPage(void) { u8g2_FirstPage(&u8g2); }
     uint8_t nextPage(void) { return u8g2_NextPage(&u8g2); }
+#ifdef U8G2_WITH_PAGE_AREA
+    void firstPageArea(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) { u8g2_FirstPageArea(&u8g2, x, y, w, h); }
+#endif
     
     #ifdef U8G2_USE_DYNAMIC_ALLOC
     void setBufferPtr(uint8_t *buf) { u8g2_SetBufferPtr(&u8g2, buf); }
@@ -211,6 +223,43 @@ class U8G2
       { u8g2_UpdateDisplay(&u8g2); }
     void refreshDisplay(void)
       { u8x8_RefreshDisplay(u8g2_GetU8x8(&u8g2)); }
+
+#ifdef U8G2_WITH_SHADOW_BUFFER
+    void setShadowBuffer(uint8_t *buf) { u8g2_SetShadowBuffer(&u8g2, buf); }
+    size_t getShadowBufferSize(void) { return u8g2_GetShadowBufferSize(&u8g2); }
+    void invalidateShadowBuffer(void) { u8g2_InvalidateShadowBuffer(&u8g2); }
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+
+#ifdef U8G2_WITH_GRAY4
+    void setGray4Buffer(uint8_t *buf, uint8_t tile_buf_height) { u8g2_SetGray4Buffer(&u8g2, buf, tile_buf_height); }
+    size_t getGray4BufferSize(uint8_t tile_buf_height) { return u8g2_GetGray4BufferSize(&u8g2, tile_buf_height); }
+    void setGrayLevel(uint8_t level) { u8g2_SetGrayLevel(&u8g2, level); }
+    uint8_t getGrayLevel(void) { return u8g2_GetGrayLevel(&u8g2); }
+#endif /* U8G2_WITH_GRAY4 */
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+    /* u8g2_display_list.c */
+    void beginDisplayList(uint16_t *buf, uint16_t size) { u8g2_BeginDisplayList(&u8g2, buf, size); }
+    uint8_t endDisplayList(void) { return u8g2_EndDisplayList(&u8g2); }
+    void drawDisplayList(void) { u8g2_DrawDisplayList(&u8g2); }
+    void sendDisplayList(void) { u8g2_SendDisplayList(&u8g2); }
+    uint16_t getDisplayListUsage(void) { return u8g2_GetDisplayListUsage(&u8g2); }
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
+#ifdef U8G2_WITH_SURFACE
+    /* u8g2_surface.c */
+    void setupSurface(uint8_t *buf, u8g2_uint_t width, u8g2_uint_t height)
+      { u8g2_SetupSurface(&u8g2, buf, width, height, u8g2_ll_hvline_vertical_top_lsb); }
+    void bitBlt(u8g2_uint_t dx, u8g2_uint_t dy, U8G2 &src, u8g2_uint_t sx, u8g2_uint_t sy, u8g2_uint_t w, u8g2_uint_t h, uint8_t rop)
+      { u8g2_BitBlt(&u8g2, dx, dy, src.getU8g2(), sx, sy, w, h, rop); }
+#endif /* U8G2_WITH_SURFACE */
+
+    /* u8g2_scroll.c */
+    void scrollBuffer(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, int16_t dx, int16_t dy)
+      { u8g2_ScrollBuffer(&u8g2, x, y, w, h, dx, dy); }
+#ifdef U8X8_WITH_SCROLL
+    uint8_t scrollDisplay(int8_t tile_rows) { return u8g2_ScrollDisplay(&u8g2, tile_rows); }
+#endif /* U8X8_WITH_SCROLL */
     
 
 
@@ -264,6 +313,13 @@ class U8G2
     /* u8g2_font.c */
 
     void setFont(const uint8_t  *font) {u8g2_SetFont(&u8g2, font); }
+#ifdef U8G2_WITH_FONT_INDEX
+    void setFontIndexBuffer(uint32_t *buf, size_t size) { u8g2_SetFontIndexBuffer(&u8g2, buf, size); }
+#endif
+#ifdef U8G2_WITH_GLYPH_CACHE
+    void setGlyphCache(void *buf, size_t size) { u8g2_SetGlyphCache(&u8g2, buf, size); }
+    void clearGlyphCache(void) { u8g2_ClearGlyphCache(&u8g2); }
+#endif
     void setFontMode(uint8_t  is_transparent) {u8g2_SetFontMode(&u8g2, is_transparent); }
     void setFontDirection(uint8_t dir) {u8g2_SetFontDirection(&u8g2, dir); }
 
@@ -440,13 +496,10 @@ class U8G2LOG
       return 1;
      }
 
+    /* the log is redrawn only once for the complete buffer */
     size_t write(const uint8_t *buffer, size_t size) {
-      size_t cnt = 0;
-      while( size > 0 ) {
-	cnt += write(*buffer++); 
-	size--;
-      }
-      return cnt;
+      u8log_WriteBuffer(&u8log, buffer, size);
+      return size;
     }  
 
     void writeString(const char *s) { u8log_WriteString(&u8log, s); }
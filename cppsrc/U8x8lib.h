@@ -208,6 +208,11 @@ class U8X8
     
     void setI2CAddress(uint8_t adr) { u8x8_SetI2CAddress(&u8x8, adr); }
 
+#ifdef U8X8_WITH_TRANSFER_BUFFER
+    /* call this before begin() */
+    void setTransferBuffer(uint8_t *buf, uint8_t size) { u8x8_SetTransferBuffer(&u8x8, buf, size); }
+#endif
+
     uint8_t getCols(void) { return u8x8_GetCols(&u8x8); }
     uint8_t getRows(void) { return u8x8_GetRows(&u8x8); }
     
@@ -277,6 +282,12 @@ class U8X8
     void clearLine(uint8_t line) {
       u8x8_ClearLine(&u8x8, line); }
 
+#ifdef U8X8_WITH_SCROLL
+    /* returns 0 if the display does not support this */
+    uint8_t scrollTileRows(int8_t cnt) {
+      return u8x8_ScrollTileRows(&u8x8, cnt); }
+#endif
+
     void setContrast(uint8_t value) {
       u8x8_SetContrast(&u8x8, value); }
 
@@ -397,13 +408,10 @@ class U8X8LOG
       return 1;
      }
 
+    /* the log is redrawn only once for the complete buffer */
     size_t write(const uint8_t *buffer, size_t size) {
-      size_t cnt = 0;
-      while( size > 0 ) {
-	cnt += write(*buffer++); 
-	size--;
-      }
-      return cnt;
+      u8log_WriteBuffer(&u8log, buffer, size);
+      return size;
     }  
 
     void writeString(const char *s) { u8log_WriteString(&u8log, s); }
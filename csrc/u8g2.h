@@ -176,6 +176,65 @@
 #endif
 
 
+/*
+  The following macro enables the shadow buffer support for u8g2_SendBuffer():
+    void u8g2_SetShadowBuffer(u8g2_t *u8g2, uint8_t *buf)
+    void u8g2_InvalidateShadowBuffer(u8g2_t *u8g2)
+  If a shadow buffer is assigned, u8g2 keeps a copy of the content which was
+  transmitted to the display and only sends those tiles, which have been changed.
+  The feature is disabled at runtime as long as no shadow buffer is assigned.
+  It is enabled for those uC which have enough RAM for a second copy of the
+  tile buffer (the shadow buffer has the size of the full tile buffer).
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_SHADOW_BUFFER
+#define U8G2_WITH_SHADOW_BUFFER
+#endif
+#endif
+
+/*
+  The following macro enables the picture loop for a part of the display:
+    void u8g2_FirstPageArea(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+  Only the tile rows (and for most displays also only the tile columns), which 
+  intersect with the given area, are drawn and sent to the display.
+  This requires the clip window support.
+*/
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+#ifndef U8G2_WITHOUT_PAGE_AREA
+#define U8G2_WITH_PAGE_AREA
+#endif
+#endif
+
+/*
+  The following macro enables the display list for the picture loop:
+    void u8g2_BeginDisplayList(u8g2_t *u8g2, uint16_t *buf, uint16_t size)
+    uint8_t u8g2_EndDisplayList(u8g2_t *u8g2)
+    void u8g2_DrawDisplayList(u8g2_t *u8g2)
+    void u8g2_SendDisplayList(u8g2_t *u8g2)
+  The draw procedures are executed only once and the result is replayed for each page.
+  Each recorded hvline requires 8 bytes in the display list, so it is enabled for 
+  those uC which have enough RAM for the list.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_DISPLAY_LIST
+#define U8G2_WITH_DISPLAY_LIST
+#endif
+#endif
+
+/*
+  The following macro enables the 4 bit per pixel buffer for grayscale displays:
+    void u8g2_SetGray4Buffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height)
+    u8g2_SetGrayLevel(u8g2, level)
+  The buffer is sent without conversion to SSD1322, SSD1327 and SH1122 displays.
+  Gray buffer support requires U8X8_WITH_GRAY4 (see u8x8.h).
+*/
+#ifdef U8X8_WITH_GRAY4
+#ifndef U8G2_WITHOUT_GRAY4
+#define U8G2_WITH_GRAY4
+#endif
+#endif
+
+
 /*==========================================*/
 
 
@@ -196,6 +255,118 @@
 #endif 
 #endif
 
+/*
+  The following macro enables the RAM glyph index for fonts:
+    void u8g2_SetFontIndexBuffer(u8g2_t *u8g2, uint32_t *buf, size_t size)
+  The index is built by u8g2_SetFont() and replaces the linear search for the glyph data.
+  It is enabled for those uC which have enough RAM for the index.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_FONT_INDEX
+#define U8G2_WITH_FONT_INDEX
+#endif
+#endif
+
+/*
+  The following macro enables the cache for decoded glyphs:
+    void u8g2_SetGlyphCache(u8g2_t *u8g2, void *buf, size_t size)
+  Decoded glyphs are stored as bitmaps in the provided memory area and are 
+  copied into the tile buffer instead of decoding the glyph again.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_GLYPH_CACHE
+#define U8G2_WITH_GLYPH_CACHE
+#endif
+#endif
+
+/*
+  The following macro enables the direct glyph drawing: For U8G2_R0 and font direction 0 
+  glyphs, which are completly visible, are written directly into the tile buffer.
+  Only glyphs, which cross the border of the current page or clip window, use u8g2_DrawHVLine().
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_DIRECT_GLYPH_DRAW
+#define U8G2_WITH_DIRECT_GLYPH_DRAW
+#endif
+#endif
+
+/*
+  The following macro enables the bitmap blitter: For U8G2_R0 the XBM and u8glib 
+  bitmap procedures clip the bitmap once against the current page and clip window 
+  and write eight pixel at once into the vertical_top_lsb or horizontal_right_lsb 
+  tile buffer. Other rotations and buffers use u8g2_DrawHVLine() for each pixel.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_BITMAP_BLIT
+#define U8G2_WITH_BITMAP_BLIT
+#endif
+#endif
+
+/*
+  The following macro enables the clipped circle and ellipse procedures:
+  Circles, discs and ellipses only calculate the rows of the current page and 
+  clip window. Discs and filled ellipses are drawn with one horizontal line per row.
+  Draw color 2 (XOR) still uses the pixel based procedures.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_CLIPPED_CIRCLE
+#define U8G2_WITH_CLIPPED_CIRCLE
+#endif
+#endif
+
+/*
+  The following macro stores the points of u8g2_AddPolygonXY() in the u8g2 
+  structure instead of one global polygon. This allows several displays to 
+  draw polygons at the same time (e.g. from different threads).
+  Each thread must remove the points with u8g2_ClearPolygon(u8g2) instead of 
+  u8g2_ClearPolygonXY().
+  It requires about 80 bytes RAM in the u8g2 structure.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_INSTANCE_POLYGON
+#define U8G2_WITH_INSTANCE_POLYGON
+#endif
+#endif
+
+/*
+  The following macro replaces the convex polygon procedure with a scan line 
+  algorithm (sorted edge table and active edge list). Only the visible scan lines 
+  of the current page are calculated and concave polygons are filled with the 
+  even-odd rule. More than U8G2_PG_MAX_POINTS points are stored in the memory area of
+    void u8g2_SetPolygonBuffer(u8g2_t *u8g2, void *buf, size_t size)
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_POLYGON_EDGE_TABLE
+#define U8G2_WITH_POLYGON_EDGE_TABLE
+#endif
+#endif
+
+/*
+  The following macro enables offscreen surfaces and the copy of rectangles 
+  between the buffers of two u8g2 structures:
+    void u8g2_SetupSurface(u8g2_t *u8g2, uint8_t *buf, u8g2_uint_t width, u8g2_uint_t height, u8g2_draw_ll_hvline_cb ll_hvline_cb)
+    void u8g2_BitBlt(u8g2_t *dst, u8g2_uint_t dx, u8g2_uint_t dy, u8g2_t *src, u8g2_uint_t sx, u8g2_uint_t sy, u8g2_uint_t w, u8g2_uint_t h, uint8_t rop)
+  A surface requires about 30 bytes RAM in the u8g2 structure for the dimension of the surface.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_SURFACE
+#define U8G2_WITH_SURFACE
+#endif
+#endif
+
+/*
+  The following macro enables the rotation of the buffer during u8g2_SendBuffer():
+    uint8_t u8g2_SetFlushRotation(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
+  With U8G2_R1 and U8G2_R3 the draw procedures use the U8G2_R0 code on an unrotated 
+  buffer. The tiles of the buffer are rotated when they are sent to the display.
+  This requires full buffer mode, see tools/rotation/benchmark for the speed.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8G2_WITHOUT_FLUSH_ROTATION
+#define U8G2_WITH_FLUSH_ROTATION
+#endif
+#endif
+
 /*==========================================*/
 /* C++ compatible */
 
@@ -310,6 +481,60 @@ struct u8g2_cb_struct
 
 typedef u8g2_uint_t (*u8g2_font_calc_vref_fnptr)(u8g2_t *u8g2);
 
+/* polygon state, see u8g2_polygon.c */
+
+typedef int16_t u8g2_pg_word_t;
+
+struct u8g2_pg_point_struct
+{
+  u8g2_pg_word_t x;
+  u8g2_pg_word_t y;
+};
+
+typedef struct _u8g2_pg_struct u8g2_pg_struct;	/* forward declaration */
+
+struct u8g2_pg_edge_struct
+{
+  u8g2_pg_word_t x_direction;	/* 1, if x2 is greater than x1, -1 otherwise */
+  u8g2_pg_word_t height;
+  u8g2_pg_word_t current_x_offset;
+  u8g2_pg_word_t error_offset;
+  
+  /* --- line loop --- */
+  u8g2_pg_word_t current_y;
+  u8g2_pg_word_t max_y;
+  u8g2_pg_word_t current_x;
+  u8g2_pg_word_t error;
+
+  /* --- outer loop --- */
+  uint8_t (*next_idx_fn)(u8g2_pg_struct *pg, uint8_t i);
+  uint8_t curr_idx;
+};
+
+/* maximum number of points in the polygon */
+/* can be redefined, but highest possible value is 254 */
+#ifndef U8G2_PG_MAX_POINTS
+#define U8G2_PG_MAX_POINTS 6
+#endif
+
+struct _u8g2_pg_struct
+{
+  struct u8g2_pg_point_struct list[U8G2_PG_MAX_POINTS];
+  uint8_t cnt;
+  uint8_t is_min_y_not_flat;
+  u8g2_pg_word_t total_scan_line_cnt;
+  struct u8g2_pg_edge_struct pge[2];	/* left and right line draw structures */
+#ifdef U8G2_WITH_INSTANCE_POLYGON
+  uint32_t clear_cnt;		/* value of the counter of u8g2_ClearPolygonXY() when the points were removed */
+#endif /* U8G2_WITH_INSTANCE_POLYGON */
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+  uint8_t *buf;			/* polygon buffer, NULL if not used, see u8g2_SetPolygonBuffer() */
+  uint16_t buf_max_cnt;		/* number of points, which fit into the polygon buffer */
+  uint16_t buf_cnt;		/* number of points in the polygon buffer */
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
+};
+
+
 
 struct u8g2_struct
 {
@@ -364,6 +589,19 @@ struct u8g2_struct
   u8g2_font_decode_t font_decode;		/* new font decode structure */
   u8g2_font_info_t font_info;			/* new font info structure */
 
+#ifdef U8G2_WITH_FONT_INDEX
+  uint32_t *font_index_ptr;		/* glyph index, NULL if not used, see u8g2_SetFontIndexBuffer() */
+  size_t font_index_size;		/* number of uint32_t words in font_index_ptr */
+  const uint8_t *font_index_font;	/* font for which the glyph index was built */
+#endif /* U8G2_WITH_FONT_INDEX */
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+  uint8_t *glyph_cache_ptr;		/* glyph cache, NULL if not used, see u8g2_SetGlyphCache() */
+  size_t glyph_cache_size;		/* number of bytes in glyph_cache_ptr */
+  size_t glyph_cache_used;		/* number of bytes occupied by cache entries */
+  uint16_t glyph_cache_clock;		/* incremented with each access, used for LRU eviction */
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 #ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
   /* 1 of there is an intersection between user_?? and clip_?? box */
   uint8_t is_page_clip_window_intersection;
@@ -382,6 +620,50 @@ struct u8g2_struct
 					
 	// the following variable should be renamed to is_buffer_auto_clear
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic clear of the buffer in firstPage() and nextPage() */
+
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  uint8_t *shadow_buf_ptr;	/* NULL or copy of the display memory with u8x8.display_info->tile_width * 8 * tile_height bytes */
+  uint8_t is_shadow_buf_invalid;	/* 1: shadow_buf_ptr does not reflect the display memory, send all tiles */
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+
+#ifdef U8G2_WITH_PAGE_AREA
+  uint8_t is_page_area;		/* 1: the picture loop was started with u8g2_FirstPageArea() */
+  uint8_t page_area_ty0;	/* first tile row of the area */
+  uint8_t page_area_ty1;	/* tile row below the area (excluded) */
+  uint8_t page_area_tx;		/* first tile column, which is sent to the display */
+  uint8_t page_area_tw;		/* number of tile columns, which are sent to the display */
+  u8g2_uint_t page_area_clip_x0;	/* clip window before u8g2_FirstPageArea(), restored by u8g2_NextPage() */
+  u8g2_uint_t page_area_clip_y0;
+  u8g2_uint_t page_area_clip_x1;
+  u8g2_uint_t page_area_clip_y1;
+#endif /* U8G2_WITH_PAGE_AREA */
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+  uint16_t *dl_ptr;		/* display list, see u8g2_display_list.c */
+  uint16_t dl_size;		/* number of uint16_t words in dl_ptr */
+  uint16_t dl_pos;		/* next free word in dl_ptr */
+  u8g2_draw_ll_hvline_cb dl_ll_hvline;	/* original low level hvline procedure during recording, NULL if not recording */
+  uint8_t dl_page_cnt;		/* number of pages in the display list, 0 if the display list is not valid */
+  uint8_t dl_is_overflow;	/* 1: the display list was too small */
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
+#ifdef U8G2_WITH_INSTANCE_POLYGON
+  u8g2_pg_struct pg;		/* points of u8g2_AddPolygonXY(), see u8g2_polygon.c */
+#endif /* U8G2_WITH_INSTANCE_POLYGON */
+
+#ifdef U8G2_WITH_GRAY4
+  uint8_t is_gray4_buffer;	/* 1: tile_buf_ptr has 4 bit per pixel, see u8g2_SetGray4Buffer() */
+  uint8_t gray_level;		/* 0..15: gray value of draw_color 1 in the 4 bit per pixel buffer */
+#endif /* U8G2_WITH_GRAY4 */
+
+#ifdef U8G2_WITH_SURFACE
+  u8x8_display_info_t surface_display_info;	/* dimension of an offscreen surface, see u8g2_SetupSurface() */
+#endif /* U8G2_WITH_SURFACE */
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  uint8_t tile_buf_width;	/* number of tiles in one tile row of the buffer */
+  const u8g2_cb_t *flush_rotation;	/* U8G2_R1 or U8G2_R3, applied by u8g2_SendBuffer(), see u8g2_SetFlushRotation() */
+#endif /* U8G2_WITH_FLUSH_ROTATION */
   
 };
 
@@ -417,6 +699,10 @@ void u8g2_ClearDisplay(u8g2_t *u8g2);
 #define u8g2_GetI2CAddress(u8g2)   u8x8_GetI2CAddress(u8g2_GetU8x8(u8g2))
 #define u8g2_SetI2CAddress(u8g2, address) ((u8g2_GetU8x8(u8g2))->i2c_address = (address))
 
+#ifdef U8X8_WITH_TRANSFER_BUFFER
+#define u8g2_SetTransferBuffer(u8g2, buf, size) u8x8_SetTransferBuffer(u8g2_GetU8x8(u8g2), (buf), (size))
+#endif
+
 #ifdef U8X8_USE_PINS 
 #define u8g2_SetMenuSelectPin(u8g2, val) u8x8_SetMenuSelectPin(u8g2_GetU8x8(u8g2), (val)) 
 #define u8g2_SetMenuNextPin(u8g2, val) u8x8_SetMenuNextPin(u8g2_GetU8x8(u8g2), (val))
@@ -437,6 +723,9 @@ extern const u8g2_cb_t u8g2_cb_r2;
 extern const u8g2_cb_t u8g2_cb_r3;
 extern const u8g2_cb_t u8g2_cb_mirror;
 extern const u8g2_cb_t u8g2_cb_mirror_vertical;
+#ifdef U8G2_WITH_FLUSH_ROTATION
+extern const u8g2_cb_t u8g2_cb_flush_rotation;
+#endif /* U8G2_WITH_FLUSH_ROTATION */
 
 #define U8G2_R0	(&u8g2_cb_r0)
 #define U8G2_R1	(&u8g2_cb_r1)
@@ -460,6 +749,9 @@ void u8g2_SetClipWindow(u8g2_t *u8g2, u8g2_uint_t clip_x0, u8g2_uint_t clip_y0,
 
 void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_draw_ll_hvline_cb ll_hvline_cb, const u8g2_cb_t *u8g2_cb);
 void u8g2_SetDisplayRotation(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb);
+#ifdef U8G2_WITH_FLUSH_ROTATION
+uint8_t u8g2_SetFlushRotation(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb);
+#endif /* U8G2_WITH_FLUSH_ROTATION */
 
 void u8g2_SendF(u8g2_t * u8g2, const char *fmt, ...);
 
@@ -1542,6 +1834,9 @@ void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2, uint8_t row) U8G2_NOINLINE;
 
 void u8g2_FirstPage(u8g2_t *u8g2);
 uint8_t u8g2_NextPage(u8g2_t *u8g2);
+#ifdef U8G2_WITH_PAGE_AREA
+void u8g2_FirstPageArea(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+#endif /* U8G2_WITH_PAGE_AREA */
 
 // Add ability to set buffer pointer
 #ifdef __ARM_LINUX__
@@ -1554,7 +1849,11 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 #endif
 #define u8g2_GetBufferPtr(u8g2) ((u8g2)->tile_buf_ptr)
 #define u8g2_GetBufferTileHeight(u8g2)	((u8g2)->tile_buf_height)
+#ifdef U8G2_WITH_FLUSH_ROTATION
+#define u8g2_GetBufferTileWidth(u8g2)	((u8g2)->tile_buf_width)
+#else
 #define u8g2_GetBufferTileWidth(u8g2)	(u8g2_GetU8x8(u8g2)->display_info->tile_width)
+#endif /* U8G2_WITH_FLUSH_ROTATION */
 /* the following variable is only valid after calling u8g2_FirstPage */
 /* renamed from Page to Buffer: the CurrTileRow is the current row of the buffer, issue #370 */
 #define u8g2_GetPageCurrTileRow(u8g2) ((u8g2)->tile_curr_row)
@@ -1563,6 +1862,21 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, uint8_t th);
 void u8g2_UpdateDisplay(u8g2_t *u8g2);
 
+#ifdef U8G2_WITH_SHADOW_BUFFER
+/* the shadow buffer always covers the complete display, also in page mode */
+#define u8g2_GetShadowBufferSize(u8g2) ((size_t)(u8g2)->u8x8.display_info->tile_width * 8 * (u8g2)->u8x8.display_info->tile_height)
+void u8g2_SetShadowBuffer(u8g2_t *u8g2, uint8_t *buf);
+void u8g2_InvalidateShadowBuffer(u8g2_t *u8g2);
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+
+#ifdef U8G2_WITH_GRAY4
+/* the gray buffer has tile_width * 32 bytes for each tile row */
+#define u8g2_GetGray4BufferSize(u8g2, tile_buf_height) ((size_t)(u8g2)->u8x8.display_info->tile_width * 32 * (tile_buf_height))
+#define u8g2_SetGrayLevel(u8g2, level) ((u8g2)->gray_level = (level) & 15)
+#define u8g2_GetGrayLevel(u8g2) ((u8g2)->gray_level)
+void u8g2_SetGray4Buffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height);
+#endif /* U8G2_WITH_GRAY4 */
+
 void u8g2_WriteBufferPBM(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferXBM(u8g2_t *u8g2, void (*out)(const char *s));
 /* SH1122, LD7032, ST7920, ST7986, LC7981, T6963, SED1330, RA8835, MAX7219, LS0 */ 
@@ -1570,6 +1884,43 @@ void u8g2_WriteBufferPBM2(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferXBM2(u8g2_t *u8g2, void (*out)(const char *s));
 
 
+/*==========================================*/
+/* u8g2_display_list.c */
+#ifdef U8G2_WITH_DISPLAY_LIST
+void u8g2_BeginDisplayList(u8g2_t *u8g2, uint16_t *buf, uint16_t size);
+uint8_t u8g2_EndDisplayList(u8g2_t *u8g2);
+void u8g2_DrawDisplayList(u8g2_t *u8g2);
+void u8g2_SendDisplayList(u8g2_t *u8g2);
+/* number of used uint16_t words, can be used to find a suitable size for the display list */
+#define u8g2_GetDisplayListUsage(u8g2) ((u8g2)->dl_pos)
+/* 1 between u8g2_BeginDisplayList() and u8g2_EndDisplayList() */
+#define u8g2_IsDisplayListRecording(u8g2) ((u8g2)->dl_ll_hvline != NULL)
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
+/*==========================================*/
+/* u8g2_surface.c */
+#ifdef U8G2_WITH_SURFACE
+/* size of the buffer for u8g2_SetupSurface() */
+#define U8G2_SURFACE_BUFFER_SIZE(width, height) ((((size_t)(width)+7)/8)*8*(((size_t)(height)+7)/8))
+void u8g2_SetupSurface(u8g2_t *u8g2, uint8_t *buf, u8g2_uint_t width, u8g2_uint_t height, u8g2_draw_ll_hvline_cb ll_hvline_cb);
+/* raster operations for u8g2_BitBlt(), dst is the pixel of the destination, src the pixel of the source */
+#define U8G2_ROP_COPY 0		/* dst = src */
+#define U8G2_ROP_OR 1		/* dst = dst | src */
+#define U8G2_ROP_AND 2		/* dst = dst & src */
+#define U8G2_ROP_XOR 3		/* dst = dst ^ src */
+#define U8G2_ROP_NOT 4		/* dst = ~src */
+void u8g2_BitBlt(u8g2_t *dst, u8g2_uint_t dx, u8g2_uint_t dy, u8g2_t *src, u8g2_uint_t sx, u8g2_uint_t sy, u8g2_uint_t w, u8g2_uint_t h, uint8_t rop);
+#endif /* U8G2_WITH_SURFACE */
+
+/*==========================================*/
+/* u8g2_scroll.c */
+void u8g2_ScrollBuffer(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, int16_t dx, int16_t dy);
+#ifdef U8X8_WITH_SCROLL
+/* returns 0 if the display does not support U8X8_MSG_DISPLAY_SET_START_TILE_ROW: send the complete buffer */
+uint8_t u8g2_ScrollDisplay(u8g2_t *u8g2, int8_t tile_rows);
+#endif /* U8X8_WITH_SCROLL */
+
+
 /*==========================================*/
 /* u8g2_ll_hvline.c */
 /*
@@ -1585,6 +1936,10 @@ void u8g2_WriteBufferXBM2(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 /* ST7920 */
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+#ifdef U8G2_WITH_GRAY4
+/* SSD1322, SSD1327, SH1122 with u8g2_SetGray4Buffer() */
+void u8g2_ll_hvline_horizontal_gray4(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+#endif /* U8G2_WITH_GRAY4 */
 
 
 /*==========================================*/
@@ -1675,9 +2030,18 @@ void u8g2_DrawButtonUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t
 /*==========================================*/
 /* u8g2_polygon.c */
 void u8g2_ClearPolygonXY(void);
+void u8g2_ClearPolygon(u8g2_t *u8g2);
 void u8g2_AddPolygonXY(u8g2_t *u8g2, int16_t x, int16_t y);
 void u8g2_DrawPolygon(u8g2_t *u8g2);
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+/* 
+  size of the polygon buffer for u8g2_SetPolygonBuffer(): 
+  each point requires one edge, the point itself and one entry of the active edge list
+*/
+#define U8G2_POLYGON_BUFFER_SIZE(point_cnt) ((size_t)(point_cnt)*(sizeof(struct u8g2_pg_edge_struct)+sizeof(struct u8g2_pg_point_struct)+sizeof(uint16_t))+sizeof(void *))
+void u8g2_SetPolygonBuffer(u8g2_t *u8g2, void *buf, size_t size);
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
 
 
 
@@ -1704,6 +2068,21 @@ size_t u8g2_GetFontSize(const uint8_t *font_arg);
 void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font);
 void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent);
 
+#ifdef U8G2_WITH_FONT_INDEX
+/* 
+  size of the glyph index buffer in uint32_t words: 
+  258 words are required for the index of the 8 bit glyphs, 
+  each unicode glyph requires another 2 words 
+*/
+#define U8G2_FONT_INDEX_SIZE(unicode_glyph_cnt) (258+2*(size_t)(unicode_glyph_cnt))
+void u8g2_SetFontIndexBuffer(u8g2_t *u8g2, uint32_t *buf, size_t size);
+#endif /* U8G2_WITH_FONT_INDEX */
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+void u8g2_SetGlyphCache(u8g2_t *u8g2, void *buf, size_t size);
+void u8g2_ClearGlyphCache(u8g2_t *u8g2);
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding);
 int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2, uint16_t requested_encoding);
 u8g2_uint_t u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
@@ -34,12 +34,235 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 
 void u8g2_SetBitmapMode(u8g2_t *u8g2, uint8_t is_transparent) {
   u8g2->bitmap_transparency = is_transparent;
 }
 
+#ifdef U8G2_WITH_BITMAP_BLIT
+
+static const uint8_t u8g2_bitmap_reverse_nibble[16] = 
+  { 0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf };
+
+/* swap the bit order of one byte: XBM is lsb first, u8glib bitmaps are msb first */
+static uint8_t u8g2_bitmap_reverse(uint8_t b)
+{
+  return (u8g2_bitmap_reverse_nibble[b & 15] << 4) | u8g2_bitmap_reverse_nibble[b >> 4];
+}
+
+/*
+  Transpose a 8x8 block: row[k] contains the pixel of line k, lsb is the left pixel.
+  col[j] will contain the pixel of column j, lsb is the top pixel (vertical_top_lsb).
+  Hacker's Delight, transpose8rS32
+*/
+static void u8g2_bitmap_transpose(uint8_t *col, const uint8_t *row)
+{
+  uint32_t x, y, t;
+  
+  x = ((uint32_t)row[7]<<24) | ((uint32_t)row[6]<<16) | ((uint32_t)row[5]<<8) | row[4];
+  y = ((uint32_t)row[3]<<24) | ((uint32_t)row[2]<<16) | ((uint32_t)row[1]<<8) | row[0];
+  
+  t = (x ^ (x >> 7)) & 0x00AA00AAUL;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAUL;  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCCUL;  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCUL;  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+  y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+  x = t;
+  
+  col[7] = x >> 24; col[6] = x >> 16; col[5] = x >> 8; col[4] = x;
+  col[3] = y >> 24; col[2] = y >> 16; col[1] = y >> 8; col[0] = y;
+}
+
+/*
+  Masks for u8g2_bitmap_blit_byte(), see u8g2_ll_hvline.c
+    color = 0:   or_mask = 1, xor_mask = 1
+    color = 1:   or_mask = 1, xor_mask = 0
+    color = 2:   or_mask = 0, xor_mask = 1
+  The background masks are 0 for the transparent mode.
+*/
+typedef struct
+{
+  uint8_t fg_or;
+  uint8_t fg_xor;
+  uint8_t bg_or;
+  uint8_t bg_xor;
+} u8g2_bitmap_rop_t;
+
+/*
+  b:		set pixel of the bitmap
+  mask:	pixel which are covered by the bitmap
+*/
+static void u8g2_bitmap_blit_byte(uint8_t *ptr, uint8_t b, uint8_t mask, const u8g2_bitmap_rop_t *rop)
+{
+  uint8_t nb;
+  b &= mask;
+  nb = mask & ~b;
+  *ptr |= (b & rop->fg_or) | (nb & rop->bg_or);
+  *ptr ^= (b & rop->fg_xor) | (nb & rop->bg_xor);
+}
+
+/*
+  Draw a bitmap directly into the tile buffer. 
+  Returns 0 if the bitmap must be drawn with u8g2_DrawHVLine() (rotated display, 
+  display list or unsupported buffer).
+  Args:
+    x, y, w, h		position and size of the bitmap
+    stride		number of bytes of one line of the bitmap
+    is_msb		0: XBM (lsb is the left pixel), 1: u8glib bitmap (msb is the left pixel)
+    is_pgm		1: use u8x8_pgm_read() for the bitmap
+*/
+static uint8_t u8g2_bitmap_blit(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t stride, const uint8_t *bitmap, uint8_t is_msb, uint8_t is_pgm)
+{
+  u8g2_bitmap_rop_t rop;
+  u8g2_uint_t cx0, cx1, cy0, cy1;	/* visible part of the bitmap */
+  u8g2_uint_t sx, sx0, sx1, sy;	/* position within the bitmap */
+  u8g2_uint_t dy, n, g;
+  uint8_t row[8];
+  uint8_t col[8];
+  uint8_t mask, b, bit_pos;
+  uint16_t v;
+  uint16_t tile_width;
+  const uint8_t *src;
+  uint8_t *ptr;
+  uint8_t ncolor;
+  
+  if ( u8g2->cb->draw_l90 != u8g2_draw_l90_r0 )
+    return 0;
+  /* the buffer might be replaced, for example by the display list */
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb && u8g2->ll_hvline != u8g2_ll_hvline_horizontal_right_lsb )
+    return 0;
+  /* wrap around of the bitmap: let u8g2_DrawHVLine() do the clipping */
+  if ( (u8g2_uint_t)(x + w) < x || (u8g2_uint_t)(y + h) < y )
+    return 0;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 1;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  
+  /* clip against the user window */
+  cx0 = x;
+  if ( cx0 < u8g2->user_x0 )
+    cx0 = u8g2->user_x0;
+  cx1 = x + w;
+  if ( cx1 > u8g2->user_x1 )
+    cx1 = u8g2->user_x1;
+  cy0 = y;
+  if ( cy0 < u8g2->user_y0 )
+    cy0 = u8g2->user_y0;
+  cy1 = y + h;
+  if ( cy1 > u8g2->user_y1 )
+    cy1 = u8g2->user_y1;
+  if ( cx0 >= cx1 || cy0 >= cy1 )
+    return 1;
+  
+  ncolor = (u8g2->draw_color == 0 ? 1 : 0);
+  rop.fg_or = u8g2->draw_color <= 1 ? 255 : 0;
+  rop.fg_xor = u8g2->draw_color != 1 ? 255 : 0;
+  rop.bg_or = 0;
+  rop.bg_xor = 0;
+  if ( u8g2->bitmap_transparency == 0 )
+  {
+    rop.bg_or = ncolor <= 1 ? 255 : 0;
+    rop.bg_xor = ncolor != 1 ? 255 : 0;
+  }
+  
+  sx0 = cx0 - x;
+  sx1 = cx1 - x;
+  
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    /* collect up to 8 lines of the bitmap for one tile row of the buffer and transpose them */
+    tile_width = u8g2_GetBufferTileWidth(u8g2);
+    dy = cy0;
+    while( dy < cy1 )
+    {
+      bit_pos = dy & 7;
+      n = 8 - bit_pos;
+      if ( n > cy1 - dy )
+	n = cy1 - dy;
+      mask = 255 << bit_pos;
+      mask &= 255 >> (8 - bit_pos - n);
+      
+      ptr = u8g2->tile_buf_ptr;
+      ptr += (uint16_t)((dy - u8g2->pixel_curr_row) & ~7) * tile_width;
+      ptr += x;
+      
+      for( g = sx0 >> 3; g <= (sx1-1) >> 3; g++ )
+      {
+	memset(row, 0, 8);
+	src = bitmap + (uint32_t)(dy - y) * stride + g;
+	for( sy = 0; sy < n; sy++ )
+	{
+	  b = is_pgm ? u8x8_pgm_read(src) : *src;
+	  if ( is_msb )
+	    b = u8g2_bitmap_reverse(b);
+	  row[bit_pos + sy] = b;
+	  src += stride;
+	}
+	u8g2_bitmap_transpose(col, row);
+	
+	sx = g*8;
+	if ( sx < sx0 )
+	  sx = sx0;
+	while( sx < sx1 && sx < g*8+8 )
+	{
+	  u8g2_bitmap_blit_byte(ptr + sx, col[sx & 7], mask, &rop);
+	  sx++;
+	}
+      }
+      dy += n;
+    }
+  }
+  else
+  {
+    /* shift each line of the bitmap to the byte position of the buffer */
+    tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+    for( dy = cy0; dy < cy1; dy++ )
+    {
+      src = bitmap + (uint32_t)(dy - y) * stride;
+      ptr = u8g2->tile_buf_ptr;
+      ptr += (uint16_t)(dy - u8g2->pixel_curr_row) * tile_width;
+      ptr += cx0 >> 3;
+      sx = sx0;
+      while( sx < sx1 )
+      {
+	bit_pos = (x + sx) & 7;
+	n = 8 - bit_pos;
+	if ( n > sx1 - sx )
+	  n = sx1 - sx;
+	mask = 255 >> bit_pos;
+	mask &= ~(uint8_t)(255 >> (bit_pos + n));
+	
+	/* fetch the pixel sx ... sx+n-1, pixel sx will be at bit 15 */
+	b = is_pgm ? u8x8_pgm_read(src + (sx >> 3)) : src[sx >> 3];
+	if ( is_msb == 0 )
+	  b = u8g2_bitmap_reverse(b);
+	v = b;
+	v <<= 8;
+	if ( (sx & 7) + n > 8 )
+	{
+	  b = is_pgm ? u8x8_pgm_read(src + (sx >> 3) + 1) : src[(sx >> 3) + 1];
+	  if ( is_msb == 0 )
+	    b = u8g2_bitmap_reverse(b);
+	  v |= b;
+	}
+	v <<= sx & 7;
+	
+	u8g2_bitmap_blit_byte(ptr, (uint8_t)((v >> 8) >> bit_pos), mask, &rop);
+	ptr++;
+	sx += n;
+      }
+    }
+  }
+  return 1;
+}
+
+#endif /* U8G2_WITH_BITMAP_BLIT */
+
 /*
   x,y 	Position on the display
   len		Length of bitmap line in pixel. Note: This differs from u8glib which had a bytecount here.
@@ -57,6 +280,11 @@ void u8g2_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_bitmap_blit(u8g2, x, y, len, 1, 0, b, 1, 0) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   mask = 128;
   while(len > 0)
@@ -92,6 +320,11 @@ void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_bitmap_blit(u8g2, x, y, w, h, cnt, bitmap, 1, 0) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   while( h > 0 )
   {
@@ -113,6 +346,11 @@ void u8g2_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len,
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_bitmap_blit(u8g2, x, y, len, 1, 0, b, 0, 0) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   mask = 1;
   while(len > 0) {
@@ -146,6 +384,11 @@ void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_bitmap_blit(u8g2, x, y, w, h, blen, bitmap, 0, 0) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   while( h > 0 )
   {
@@ -170,6 +413,11 @@ void u8g2_DrawHXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len,
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_bitmap_blit(u8g2, x, y, len, 1, 0, b, 0, 1) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   mask = 1;
   while(len > 0)
@@ -205,6 +453,11 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_bitmap_blit(u8g2, x, y, w, h, blen, bitmap, 0, 1) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   while( h > 0 )
   {
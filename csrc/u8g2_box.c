@@ -45,6 +45,25 @@ void u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_CLIPPED_CIRCLE
+  /* only draw the rows of the current page and clip window (used by u8g2_DrawRBox) */
+  if ( (u8g2_uint_t)(y+h) >= y )
+  {
+    if ( y < u8g2->user_y0 )
+    {
+      if ( (u8g2_uint_t)(y+h) <= u8g2->user_y0 )
+	return;
+      h -= u8g2->user_y0 - y;
+      y = u8g2->user_y0;
+    }
+    if ( (u8g2_uint_t)(y+h) > u8g2->user_y1 )
+    {
+      if ( y >= u8g2->user_y1 )
+	return;
+      h = u8g2->user_y1 - y;
+    }
+  }
+#endif /* U8G2_WITH_CLIPPED_CIRCLE */
   while( h != 0 )
   { 
     u8g2_DrawHVLine(u8g2, x, y, w, 0);
@@ -43,11 +43,265 @@ void u8g2_ClearBuffer(u8g2_t *u8g2)
   cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
   cnt *= u8g2->tile_buf_height;
   cnt *= 8;
+#ifdef U8G2_WITH_GRAY4
+  if ( u8g2->is_gray4_buffer != 0 )
+    cnt *= 4;
+#endif /* U8G2_WITH_GRAY4 */
   memset(u8g2->tile_buf_ptr, 0, cnt);
 }
 
 /*============================================*/
 
+#ifdef U8G2_WITH_SHADOW_BUFFER
+
+/*
+  Description:
+    Assign a shadow buffer to u8g2. The shadow buffer must have
+    u8g2_GetShadowBufferSize() bytes (tile_width * 8 * tile_height of the
+    display), independently from the page buffer size.
+    As long as a shadow buffer is assigned, u8g2_SendBuffer(), u8g2_NextPage()
+    and u8g2_UpdateDisplay() will only transmit those tiles, which differ from
+    the shadow buffer.
+    The first transfer after this call will send all tiles.
+    Use NULL to disable the shadow buffer.
+
+  Limitations:
+    - Tile granularity requires a display with U8x8 API and the 
+      u8g2_ll_hvline_vertical_top_lsb memory architecture. For all other displays
+      only unchanged tile rows are skipped.
+    - Any modification of the display memory outside of u8g2 (for example
+      u8x8_ClearDisplay) requires a call to u8g2_InvalidateShadowBuffer()
+*/
+void u8g2_SetShadowBuffer(u8g2_t *u8g2, uint8_t *buf)
+{
+  u8g2->shadow_buf_ptr = buf;
+  u8g2->is_shadow_buf_invalid = 1;
+}
+
+/* force transfer of all tiles with the next u8g2_SendBuffer() or picture loop */
+void u8g2_InvalidateShadowBuffer(u8g2_t *u8g2)
+{
+  u8g2->is_shadow_buf_invalid = 1;
+}
+
+static uint8_t *u8g2_get_shadow_tile_row(u8g2_t *u8g2, uint8_t tile_row)
+{
+  size_t offset;
+  offset = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  offset *= 8;
+  offset *= tile_row;
+  return u8g2->shadow_buf_ptr + offset;
+}
+
+/*
+  ptr points to the tile row inside the page buffer.
+  Compare the tile row with the shadow buffer and send changed tiles only.
+*/
+static void u8g2_send_changed_tiles(u8g2_t *u8g2, uint8_t *ptr, uint8_t dest_tile_row)
+{
+  uint8_t *shadow;
+  uint8_t w;
+  uint8_t tx;
+  uint8_t cnt;
+  
+  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  shadow = u8g2_get_shadow_tile_row(u8g2, dest_tile_row);
+  
+  if ( u8g2->is_shadow_buf_invalid == 0 )
+  {
+    if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    {
+      /* the tile row is not a sequence of independent 8x8 tiles, send the complete row */
+      if ( memcmp(shadow, ptr, (size_t)w*8) == 0 )
+	return;
+    }
+    else
+    {
+      tx = 0;
+      while( tx < w )
+      {
+	if ( memcmp(shadow+tx*8, ptr+tx*8, 8) == 0 )
+	{
+	  tx++;
+	}
+	else
+	{
+	  cnt = 1;
+	  while( tx+cnt < w && memcmp(shadow+(tx+cnt)*8, ptr+(tx+cnt)*8, 8) != 0 )
+	    cnt++;
+	  memcpy(shadow+tx*8, ptr+tx*8, cnt*8);
+	  u8x8_DrawTile(u8g2_GetU8x8(u8g2), tx, dest_tile_row, cnt, ptr+tx*8);
+	  tx += cnt;
+	}
+      }
+      return;
+    }
+  }
+  memcpy(shadow, ptr, (size_t)w*8);
+  u8x8_DrawTile(u8g2_GetU8x8(u8g2), 0, dest_tile_row, w, ptr);
+}
+
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+
+#ifdef U8G2_WITH_GRAY4
+
+/*
+  Description:
+    Replace the page buffer by a buffer with 4 bit per pixel. The buffer must have
+    u8g2_GetGray4BufferSize(u8g2, tile_buf_height) bytes. Each byte contains two
+    pixel, the left pixel is the upper nibble.
+    Draw color 1 will use the gray level (u8g2_SetGrayLevel(), default 15), color 0
+    clears the pixel and color 2 inverts the gray value.
+    The setup procedure of the display (u8g2_SetupBuffer) restores the
+    monochrome buffer.
+
+  Limitations:
+    - Direct write (U8X8_MSG_DISPLAY_DRAW_GRAY4) is only supported by SSD1322, SSD1327 
+      and SH1122 displays. All other displays with U8x8 API receive monochrome tiles 
+      (gray level 8 and above).
+    - The shadow buffer is not used.
+*/
+void u8g2_SetGray4Buffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height)
+{
+  u8g2->ll_hvline = u8g2_ll_hvline_horizontal_gray4;
+  u8g2->tile_buf_ptr = buf;
+  u8g2->tile_buf_height = tile_buf_height;
+  u8g2->is_gray4_buffer = 1;
+  u8g2_SetBufferCurrTileRow(u8g2, 0);
+}
+
+/*
+  ptr points to the first pixel row of tile row dest_tile_row inside the gray buffer.
+  Send "rows" tile rows with one message to the display. If this is not supported by
+  the display, convert the gray values to monochrome tiles.
+*/
+static void u8g2_send_gray4_tile_rows(u8g2_t *u8g2, uint8_t *ptr, uint8_t dest_tile_row, uint8_t rows)
+{
+  uint8_t tile[8];
+  uint8_t *p;
+  uint8_t w;
+  uint8_t tx, i, j, v;
+  
+  if ( rows == 0 )
+    return;
+  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  u8g2->is_shadow_buf_invalid = 1;	/* the shadow buffer is not updated */
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+  if ( u8x8_DrawGray4(u8g2_GetU8x8(u8g2), 0, dest_tile_row, w, rows, ptr) != 0 )
+    return;
+  
+  while( rows > 0 )
+  {
+    for( tx = 0; tx < w; tx++ )
+    {
+      memset(tile, 0, 8);
+      p = ptr + tx*4;
+      for( i = 0; i < 8; i++ )
+      {
+	for( j = 0; j < 8; j++ )
+	{
+	  v = p[j>>1];
+	  if ( (j & 1) == 0 )
+	    v >>= 4;
+	  if ( (v & 15) >= 8 )
+	    tile[j] |= 1<<i;
+	}
+	p += w*4;
+      }
+      u8x8_DrawTile(u8g2_GetU8x8(u8g2), tx, dest_tile_row, 1, tile);
+    }
+    ptr += (size_t)w*32;
+    dest_tile_row++;
+    rows--;
+  }
+}
+
+#endif /* U8G2_WITH_GRAY4 */
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+
+/* number of rotated tiles, which are sent with one u8x8_DrawTile() */
+#define U8G2_FLUSH_ROTATION_TILE_CNT 16
+
+/*
+  Rotate the tiles of the unrotated buffer (see u8g2_SetFlushRotation()) and send
+  them to the display. tx, ty, tw and th are tile positions and sizes of the display.
+  If a shadow buffer is assigned, unchanged tiles are not sent.
+*/
+static void u8g2_send_flush_rotation_area(u8g2_t *u8g2, uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th)
+{
+  uint8_t tiles[U8G2_FLUSH_ROTATION_TILE_CNT*8];
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  uint8_t is_clockwise = u8g2->flush_rotation == U8G2_R1;
+  uint8_t *src;
+  uint8_t *tile;
+  uint8_t x, x_end, start, cnt;
+  uint16_t offset;
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  uint8_t *shadow;
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+  
+  x_end = tx + tw;
+  while( th > 0 )
+  {
+    start = tx;
+    cnt = 0;
+    for( x = tx; x < x_end; x++ )
+    {
+      /* U8G2_R1: the tile column ty of the buffer becomes the tile row ty of the display (right to left) */
+      /* U8G2_R3: the tile column ty of the buffer becomes the tile row tile_height-1-ty of the display */
+      if ( is_clockwise )
+      {
+	offset = display_info->tile_width-1-x;
+	offset *= display_info->tile_height;
+	offset += ty;
+      }
+      else
+      {
+	offset = x;
+	offset *= display_info->tile_height;
+	offset += display_info->tile_height-1-ty;
+      }
+      offset *= 8;
+      src = u8g2->tile_buf_ptr + offset;
+      tile = tiles + cnt*8;
+      u8x8_convert_rotate_tile(tile, src, is_clockwise);
+      
+#ifdef U8G2_WITH_SHADOW_BUFFER
+      if ( u8g2->shadow_buf_ptr != NULL )
+      {
+	shadow = u8g2_get_shadow_tile_row(u8g2, ty) + x*8;
+	if ( u8g2->is_shadow_buf_invalid == 0 && memcmp(shadow, tile, 8) == 0 )
+	{
+	  /* unchanged tile: send the pending tiles */
+	  if ( cnt > 0 )
+	    u8x8_DrawTile(u8g2_GetU8x8(u8g2), start, ty, cnt, tiles);
+	  start = x+1;
+	  cnt = 0;
+	  continue;
+	}
+	memcpy(shadow, tile, 8);
+      }
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+      
+      cnt++;
+      if ( cnt >= U8G2_FLUSH_ROTATION_TILE_CNT )
+      {
+	u8x8_DrawTile(u8g2_GetU8x8(u8g2), start, ty, cnt, tiles);
+	start = x+1;
+	cnt = 0;
+      }
+    }
+    if ( cnt > 0 )
+      u8x8_DrawTile(u8g2_GetU8x8(u8g2), start, ty, cnt, tiles);
+    ty++;
+    th--;
+  }
+}
+
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
 static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_tile_row)
 {
   uint8_t *ptr;
@@ -60,6 +314,27 @@ static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_
   offset *= w;
   offset *= 8;
   ptr += offset;
+#ifdef U8G2_WITH_PAGE_AREA
+  if ( u8g2->is_page_area != 0 && u8g2->page_area_tw < w )
+  {
+    /* only send the tile columns of the area, see u8g2_FirstPageArea() */
+    ptr += u8g2->page_area_tx*8;
+#ifdef U8G2_WITH_SHADOW_BUFFER
+    if ( u8g2->shadow_buf_ptr != NULL )
+      memcpy(u8g2_get_shadow_tile_row(u8g2, dest_tile_row)+u8g2->page_area_tx*8, ptr, (size_t)u8g2->page_area_tw*8);
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+    if ( u8g2->page_area_tw > 0 )
+      u8x8_DrawTile(u8g2_GetU8x8(u8g2), u8g2->page_area_tx, dest_tile_row, u8g2->page_area_tw, ptr);
+    return;
+  }
+#endif /* U8G2_WITH_PAGE_AREA */
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  if ( u8g2->shadow_buf_ptr != NULL )
+  {
+    u8g2_send_changed_tiles(u8g2, ptr, dest_tile_row);
+    return;
+  }
+#endif /* U8G2_WITH_SHADOW_BUFFER */
   u8x8_DrawTile(u8g2_GetU8x8(u8g2), 0, dest_tile_row, w, ptr);
 }
 
@@ -81,12 +356,69 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
   dest_row = u8g2->tile_curr_row;
   dest_max = u8g2_GetU8x8(u8g2)->display_info->tile_height;
   
+#ifdef U8G2_WITH_PAGE_AREA
+  if ( u8g2->is_page_area != 0 )
+  {
+    /* only send the tile rows of the area, in full buffer mode the buffer starts above the area */
+    if ( dest_row < u8g2->page_area_ty0 )
+    {
+      src_row = u8g2->page_area_ty0 - dest_row;
+      dest_row = u8g2->page_area_ty0;
+    }
+    dest_max = u8g2->page_area_ty1;
+    if ( src_row >= src_max || dest_row >= dest_max )
+      return;
+  }
+#endif /* U8G2_WITH_PAGE_AREA */
+  
+#ifdef U8G2_WITH_GRAY4
+  if ( u8g2->is_gray4_buffer != 0 )
+  {
+    /* all tile rows of the buffer are one memory window of the display */
+    src_max -= src_row;
+    if ( src_max > dest_max - dest_row )
+      src_max = dest_max - dest_row;
+    u8g2_send_gray4_tile_rows(u8g2, u8g2->tile_buf_ptr + (size_t)u8g2_GetU8x8(u8g2)->display_info->tile_width*32*src_row, dest_row, src_max);
+    return;
+  }
+#endif /* U8G2_WITH_GRAY4 */
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  if ( u8g2->cb == &u8g2_cb_flush_rotation )
+  {
+    /* the buffer contains the complete display */
+#ifdef U8G2_WITH_PAGE_AREA
+    if ( u8g2->is_page_area != 0 )
+    {
+      u8g2_send_flush_rotation_area(u8g2, u8g2->page_area_tx, dest_row, u8g2->page_area_tw, dest_max - dest_row);
+      return;
+    }
+#endif /* U8G2_WITH_PAGE_AREA */
+    u8g2_send_flush_rotation_area(u8g2, 0, 0, u8g2_GetU8x8(u8g2)->display_info->tile_width, dest_max);
+#ifdef U8G2_WITH_SHADOW_BUFFER
+    u8g2->is_shadow_buf_invalid = 0;
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+    return;
+  }
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
   do
   {
     u8g2_send_tile_row(u8g2, src_row, dest_row);
     src_row++;
     dest_row++;
   } while( src_row < src_max && dest_row < dest_max );
+  
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  /* all tile rows of the display have been sent at least once */
+  if ( dest_row >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
+  {
+#ifdef U8G2_WITH_PAGE_AREA
+    if ( u8g2->is_page_area == 0 )
+#endif /* U8G2_WITH_PAGE_AREA */
+      u8g2->is_shadow_buf_invalid = 0;
+  }
+#endif /* U8G2_WITH_SHADOW_BUFFER */
 }
 
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
@@ -106,6 +438,9 @@ void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2, uint8_t row)
 
 void u8g2_FirstPage(u8g2_t *u8g2)
 {
+#ifdef U8G2_WITH_PAGE_AREA
+  u8g2->is_page_area = 0;
+#endif /* U8G2_WITH_PAGE_AREA */
   if ( u8g2->is_auto_page_clear )
   {
     u8g2_ClearBuffer(u8g2);
@@ -113,14 +448,238 @@ void u8g2_FirstPage(u8g2_t *u8g2)
   u8g2_SetBufferCurrTileRow(u8g2, 0);
 }
 
+#ifdef U8G2_WITH_PAGE_AREA
+/*
+  Description:
+    Same as u8g2_FirstPage(), but the picture loop is limited to the area x, y, w, h
+    (pixel, same coordinates as for the draw procedures). Only the tile rows, which 
+    intersect with the area are drawn and sent to the display. For displays with 
+    the u8g2_ll_hvline_vertical_top_lsb memory architecture also only the tile columns 
+    of the area are sent.
+    The clip window is reduced to the tiles, which are sent to the display, so the
+    border tiles are drawn completely (also the pixel outside of the area). 
+    u8g2_NextPage() will restore the previous clip window after the last page.
+    
+  Limitations:
+    - Unknown rotation procedures will send the complete tile rows of the display.
+    - The picture loop must not be aborted, otherwise the clip window is not restored.
+*/
+void u8g2_FirstPageArea(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  const u8g2_cb_t *cb = u8g2->cb;
+  u8g2_uint_t x1, y1;
+  u8g2_uint_t dx0, dx1, dy0, dy1;	/* area in pixel of the display (unrotated) */
+  uint16_t px1, py1;
+  uint8_t ty;
+  
+  /* limit the area to the display */
+  if ( x > u8g2->width )
+    x = u8g2->width;
+  if ( w > u8g2->width - x )
+    w = u8g2->width - x;
+  if ( y > u8g2->height )
+    y = u8g2->height;
+  if ( h > u8g2->height - y )
+    h = u8g2->height - y;
+  x1 = x + w;
+  y1 = y + h;
+  
+  /* undo the rotation, see u8g2_draw_l90_r1() and friends */
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  if ( cb == &u8g2_cb_flush_rotation )
+    cb = u8g2->flush_rotation;
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+  dx0 = x;
+  dx1 = x1;
+  dy0 = y;
+  dy1 = y1;
+  if ( cb == U8G2_R1 )
+  {
+    dx0 = u8g2->height - y1;
+    dx1 = u8g2->height - y;
+    dy0 = x;
+    dy1 = x1;
+  }
+  else if ( cb == U8G2_R2 )
+  {
+    dx0 = u8g2->width - x1;
+    dx1 = u8g2->width - x;
+    dy0 = u8g2->height - y1;
+    dy1 = u8g2->height - y;
+  }
+  else if ( cb == U8G2_R3 )
+  {
+    dx0 = y;
+    dx1 = y1;
+    dy0 = u8g2->width - x1;
+    dy1 = u8g2->width - x;
+  }
+  else if ( cb == U8G2_MIRROR )
+  {
+    dx0 = u8g2->width - x1;
+    dx1 = u8g2->width - x;
+  }
+  else if ( cb == U8G2_MIRROR_VERTICAL )
+  {
+    dy0 = u8g2->height - y1;
+    dy1 = u8g2->height - y;
+  }
+  else if ( cb != U8G2_R0 )
+  {
+    dx0 = 0;
+    dx1 = display_info->pixel_width;
+    dy0 = 0;
+    dy1 = display_info->pixel_height;
+  }
+  
+  /* convert to tiles */
+  dx0 >>= 3;
+  dx1 = (dx1+7) >> 3;
+  dy0 >>= 3;
+  dy1 = (dy1+7) >> 3;
+  if ( dx1 > display_info->tile_width )
+    dx1 = display_info->tile_width;
+  if ( dy1 > display_info->tile_height )
+    dy1 = display_info->tile_height;
+  if ( w == 0 || h == 0 || dx0 >= dx1 || dy0 >= dy1 )
+  {
+    /* empty area: one page without any output */
+    dx0 = 0;
+    dx1 = 0;
+    dy0 = 0;
+    dy1 = 0;
+  }
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+  {
+    /* the tile row can not be split into independent tiles */
+    dx0 = 0;
+    dx1 = display_info->tile_width;
+  }
+  
+  u8g2->is_page_area = 1;
+  u8g2->page_area_ty0 = dy0;
+  u8g2->page_area_ty1 = dy1;
+  u8g2->page_area_tx = dx0;
+  u8g2->page_area_tw = dx1 - dx0;
+  u8g2->page_area_clip_x0 = u8g2->clip_x0;
+  u8g2->page_area_clip_y0 = u8g2->clip_y0;
+  u8g2->page_area_clip_x1 = u8g2->clip_x1;
+  u8g2->page_area_clip_y1 = u8g2->clip_y1;
+  
+  /* the tiles in pixel of the display, the last tile might be outside of the display */
+  px1 = dx1;
+  px1 *= 8;
+  if ( px1 > display_info->pixel_width )
+    px1 = display_info->pixel_width;
+  dx0 *= 8;
+  dx1 = px1;
+  py1 = dy1;
+  py1 *= 8;
+  if ( py1 > display_info->pixel_height )
+    py1 = display_info->pixel_height;
+  ty = dy0;
+  dy0 *= 8;
+  dy1 = py1;
+  
+  /* rotate the tiles back to the clip window, u8g2->width and height are still rotated */
+  if ( cb == U8G2_R1 )
+  {
+    x = dy0;
+    x1 = dy1;
+    dy0 = u8g2->height - dx1;
+    dy1 = u8g2->height - dx0;
+  }
+  else if ( cb == U8G2_R2 )
+  {
+    x = u8g2->width - dx1;
+    x1 = u8g2->width - dx0;
+    dy1 = u8g2->height - dy0;
+    dy0 = u8g2->height - py1;
+  }
+  else if ( cb == U8G2_R3 )
+  {
+    x = u8g2->width - dy1;
+    x1 = u8g2->width - dy0;
+    dy0 = dx0;
+    dy1 = dx1;
+  }
+  else if ( cb == U8G2_MIRROR )
+  {
+    x = u8g2->width - dx1;
+    x1 = u8g2->width - dx0;
+  }
+  else if ( cb == U8G2_MIRROR_VERTICAL )
+  {
+    x = dx0;
+    x1 = dx1;
+    dy1 = u8g2->height - dy0;
+    dy0 = u8g2->height - py1;
+  }
+  else if ( cb == U8G2_R0 )
+  {
+    x = dx0;
+    x1 = dx1;
+  }
+  else
+  {
+    x = 0;
+    x1 = u8g2->width;
+    dy0 = 0;
+    dy1 = u8g2->height;
+  }
+  
+  /* intersect with the clip window of the caller */
+  if ( x < u8g2->clip_x0 )
+    x = u8g2->clip_x0;
+  if ( x1 > u8g2->clip_x1 )
+    x1 = u8g2->clip_x1;
+  if ( dy0 < u8g2->clip_y0 )
+    dy0 = u8g2->clip_y0;
+  if ( dy1 > u8g2->clip_y1 )
+    dy1 = u8g2->clip_y1;
+  if ( x1 <= x || dy1 <= dy0 )
+  {
+    /* empty clip window: 0,0,0,0 has no intersection with any page (see u8g2_is_intersection_decision_tree) */
+    x = 0;
+    x1 = 0;
+    dy0 = 0;
+    dy1 = 0;
+  }
+  
+  if ( u8g2->is_auto_page_clear )
+  {
+    u8g2_ClearBuffer(u8g2);
+  }
+  u8g2_SetClipWindow(u8g2, x, dy0, x1, dy1);
+  /* in full buffer mode the buffer always starts with the first tile row of the display */
+  if ( u8g2->tile_buf_height >= display_info->tile_height )
+    ty = 0;
+  u8g2_SetBufferCurrTileRow(u8g2, ty);
+}
+#endif /* U8G2_WITH_PAGE_AREA */
+
 uint8_t u8g2_NextPage(u8g2_t *u8g2)
 {
   uint8_t row;
+  uint8_t row_max;
   u8g2_send_buffer(u8g2);
   row = u8g2->tile_curr_row;
   row += u8g2->tile_buf_height;
-  if ( row >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
+  row_max = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+#ifdef U8G2_WITH_PAGE_AREA
+  if ( u8g2->is_page_area != 0 )
+    row_max = u8g2->page_area_ty1;
+#endif /* U8G2_WITH_PAGE_AREA */
+  if ( row >= row_max )
   {
+#ifdef U8G2_WITH_PAGE_AREA
+    if ( u8g2->is_page_area != 0 )
+    {
+      u8g2->is_page_area = 0;
+      u8g2_SetClipWindow(u8g2, u8g2->page_area_clip_x0, u8g2->page_area_clip_y0, u8g2->page_area_clip_x1, u8g2->page_area_clip_y1);
+    }
+#endif /* U8G2_WITH_PAGE_AREA */
     u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
     return 0;
   }
@@ -149,6 +708,10 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2)
     - Any display rotation/mirror is ignored
     - Only works with displays, which support U8x8 API
     - Will not send the e-paper refresh message (will probably not work with e-paper devices)
+    - An assigned shadow buffer is updated, but not used to skip unchanged tiles
+    - The 4 bit per pixel buffer (u8g2_SetGray4Buffer) is sent with complete tile rows
+    - With u8g2_SetFlushRotation() the tiles are rotated, but the arguments are still
+      tile positions of the display
 */
 void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, uint8_t th)
 {
@@ -159,6 +722,24 @@ void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, u
   if ( u8g2->tile_buf_height != u8g2_GetU8x8(u8g2)->display_info->tile_height )
     return; /* not in full buffer mode, do nothing */
 
+#ifdef U8G2_WITH_GRAY4
+  if ( u8g2->is_gray4_buffer != 0 )
+  {
+    ptr = u8g2_GetBufferPtr(u8g2);
+    ptr += (size_t)u8g2_GetU8x8(u8g2)->display_info->tile_width*32*ty;
+    u8g2_send_gray4_tile_rows(u8g2, ptr, ty, th);
+    return;
+  }
+#endif /* U8G2_WITH_GRAY4 */
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  if ( u8g2->cb == &u8g2_cb_flush_rotation )
+  {
+    u8g2_send_flush_rotation_area(u8g2, tx, ty, tw, th);
+    return;
+  }
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
   page_size = u8g2->pixel_buf_width;  /* 8*u8g2->u8g2_GetU8x8(u8g2)->display_info->tile_width */
     
   ptr = u8g2_GetBufferPtr(u8g2);
@@ -168,6 +749,10 @@ void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, u
   while( th > 0 )
   {
     u8x8_DrawTile( u8g2_GetU8x8(u8g2), tx, ty, tw, ptr );
+#ifdef U8G2_WITH_SHADOW_BUFFER
+    if ( u8g2->shadow_buf_ptr != NULL )
+      memcpy(u8g2_get_shadow_tile_row(u8g2, ty)+tx*8, ptr, (size_t)tw*8);
+#endif /* U8G2_WITH_SHADOW_BUFFER */
     ptr += page_size;
     ty++;
     th--;
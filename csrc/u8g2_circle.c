@@ -35,6 +35,464 @@
 
 #include "u8g2.h"
 
+#ifdef U8G2_WITH_CLIPPED_CIRCLE
+/*==============================================*/
+/* Clipped circle, disc and ellipse */
+
+/*
+  The following procedures calculate the same pixel as the procedures below, 
+  but the pixel are drawn as horizontal or vertical runs. Only the rows, which 
+  are visible in the current page and clip window, are drawn. The loops stop 
+  as soon as all remaining rows are outside of the visible area.
+  Some pixel are drawn twice, so these procedures are not used for draw color 2 (XOR).
+  
+  b is the distance of a row to the center row y0: The row is y0-b for the upper 
+  quadrants and y0+b for the lower quadrants.
+*/
+
+/*
+  Calculate the visible range b0 <= b <= b1 of the distance b to the center row.
+  Returns 0 if no row is visible.
+*/
+static uint8_t u8g2_get_circle_rows(u8g2_t *u8g2, u8g2_uint_t y0, uint8_t option, u8g2_uint_t *b0, u8g2_uint_t *b1)
+{
+  u8g2_uint_t lo, hi;
+  uint8_t is_visible = 0;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 0;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  if ( u8g2->user_y0 >= u8g2->user_y1 )
+    return 0;
+  
+  *b0 = (u8g2_uint_t)~(u8g2_uint_t)0;
+  *b1 = 0;
+  if ( option & (U8G2_DRAW_UPPER_RIGHT|U8G2_DRAW_UPPER_LEFT) )
+  {
+    lo = y0 - (u8g2_uint_t)(u8g2->user_y1-1);
+    hi = y0 - u8g2->user_y0;
+    if ( lo > hi )
+      lo = 0;		/* y0 is inside the visible area */
+    if ( *b0 > lo ) 
+      *b0 = lo;
+    if ( *b1 < hi ) 
+      *b1 = hi;
+    is_visible = 1;
+  }
+  if ( option & (U8G2_DRAW_LOWER_LEFT|U8G2_DRAW_LOWER_RIGHT) )
+  {
+    lo = u8g2->user_y0 - y0;
+    hi = (u8g2_uint_t)(u8g2->user_y1-1) - y0;
+    if ( lo > hi )
+      lo = 0;		/* y0 is inside the visible area */
+    if ( *b0 > lo ) 
+      *b0 = lo;
+    if ( *b1 < hi ) 
+      *b1 = hi;
+    is_visible = 1;
+  }
+  return is_visible;
+}
+
+/* draw the pixel x0+xa ... x0+xb (right) and x0-xb ... x0-xa (left) in row y */
+static void u8g2_draw_circle_hspan(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y, u8g2_uint_t xa, u8g2_uint_t xb, uint8_t is_left, uint8_t is_right)
+{
+  u8g2_uint_t len;
+  
+  if ( is_left != 0 && is_right != 0 && xa == 0 )
+  {
+    /* one span from the left to the right border */
+    len = xb;
+    len *= 2;
+    len++;
+    u8g2_DrawHVLine(u8g2, x0-xb, y, len, 0);
+    return;
+  }
+  len = xb-xa+1;
+  if ( is_right != 0 )
+    u8g2_DrawHVLine(u8g2, x0+xa, y, len, 0);
+  if ( is_left != 0 )
+    u8g2_DrawHVLine(u8g2, x0-xb, y, len, 0);
+}
+
+/* horizontal run from xa to xb in the rows with the distance b to the center row */
+static void u8g2_draw_circle_hrun(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t b, u8g2_uint_t xa, u8g2_uint_t xb, uint8_t option, u8g2_uint_t b0, u8g2_uint_t b1)
+{
+  if ( b < b0 || b > b1 )
+    return;
+  if ( b == 0 )
+  {
+    /* upper and lower quadrants share the center row */
+    u8g2_draw_circle_hspan(u8g2, x0, y0, xa, xb, option & (U8G2_DRAW_UPPER_LEFT|U8G2_DRAW_LOWER_LEFT), option & (U8G2_DRAW_UPPER_RIGHT|U8G2_DRAW_LOWER_RIGHT));
+    return;
+  }
+  if ( option & (U8G2_DRAW_UPPER_RIGHT|U8G2_DRAW_UPPER_LEFT) )
+    u8g2_draw_circle_hspan(u8g2, x0, y0-b, xa, xb, option & U8G2_DRAW_UPPER_LEFT, option & U8G2_DRAW_UPPER_RIGHT);
+  if ( option & (U8G2_DRAW_LOWER_LEFT|U8G2_DRAW_LOWER_RIGHT) )
+    u8g2_draw_circle_hspan(u8g2, x0, y0+b, xa, xb, option & U8G2_DRAW_LOWER_LEFT, option & U8G2_DRAW_LOWER_RIGHT);
+}
+
+/* vertical run in the columns x0+a and x0-a from the distance ba to bb */
+static void u8g2_draw_circle_vrun(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t a, u8g2_uint_t ba, u8g2_uint_t bb, uint8_t option, u8g2_uint_t b0, u8g2_uint_t b1)
+{
+  u8g2_uint_t len;
+  
+  if ( bb < b0 || ba > b1 )
+    return;
+  len = bb-ba+1;
+  if ( option & U8G2_DRAW_UPPER_RIGHT )
+    u8g2_DrawHVLine(u8g2, x0+a, y0-bb, len, 1);
+  if ( (option & U8G2_DRAW_UPPER_LEFT) && ( a != 0 || (option & U8G2_DRAW_UPPER_RIGHT) == 0 ) )
+    u8g2_DrawHVLine(u8g2, x0-a, y0-bb, len, 1);
+  if ( option & U8G2_DRAW_LOWER_RIGHT )
+    u8g2_DrawHVLine(u8g2, x0+a, y0+ba, len, 1);
+  if ( (option & U8G2_DRAW_LOWER_LEFT) && ( a != 0 || (option & U8G2_DRAW_LOWER_RIGHT) == 0 ) )
+    u8g2_DrawHVLine(u8g2, x0-a, y0+ba, len, 1);
+}
+
+/*
+  Same loop as u8g2_draw_circle(). All steps with the same y are collected:
+  The first octant is a horizontal run in row y, the second octant is a 
+  vertical run in column y. The remaining rows are always between x and y.
+*/
+static void u8g2_draw_clipped_circle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
+{
+  u8g2_int_t f;
+  u8g2_int_t ddF_x;
+  u8g2_int_t ddF_y;
+  u8g2_uint_t x;
+  u8g2_uint_t y;
+  u8g2_uint_t xa;		/* first x of the current run */
+  u8g2_uint_t b0, b1;
+  
+  if ( u8g2_get_circle_rows(u8g2, y0, option, &b0, &b1) == 0 )
+    return;
+
+  f = 1;
+  f -= rad;
+  ddF_x = 1;
+  ddF_y = 0;
+  ddF_y -= rad;
+  ddF_y *= 2;
+  x = 0;
+  y = rad;
+  xa = 0;
+  
+  while ( x < y )
+  {
+    if (f >= 0) 
+    {
+      /* y will change: draw the run from xa to x */
+      u8g2_draw_circle_hrun(u8g2, x0, y0, y, xa, x, option, b0, b1);
+      u8g2_draw_circle_vrun(u8g2, x0, y0, y, xa, x, option, b0, b1);
+      xa = x+1;
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+      if ( xa > b1 || y < b0 )
+	return;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+  }
+  u8g2_draw_circle_hrun(u8g2, x0, y0, y, xa, x, option, b0, b1);
+  u8g2_draw_circle_vrun(u8g2, x0, y0, y, xa, x, option, b0, b1);
+}
+
+/*
+  Same loop as u8g2_draw_disc(), but the disc is drawn with one horizontal
+  line per row. The union of the vertical lines of u8g2_draw_disc_section() is:
+    row x (second octant): half width y
+    row y (first octant): half width of the last x with this y, this row
+      is drawn when y changes (except if the row is also a second octant row)
+  The remaining rows are always between x and y+1.
+*/
+static void u8g2_draw_clipped_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
+{
+  u8g2_int_t f;
+  u8g2_int_t ddF_x;
+  u8g2_int_t ddF_y;
+  u8g2_uint_t x;
+  u8g2_uint_t y;
+  u8g2_uint_t b0, b1;
+  
+  if ( u8g2_get_circle_rows(u8g2, y0, option, &b0, &b1) == 0 )
+    return;
+
+  f = 1;
+  f -= rad;
+  ddF_x = 1;
+  ddF_y = 0;
+  ddF_y -= rad;
+  ddF_y *= 2;
+  x = 0;
+  y = rad;
+  
+  for(;;)
+  {
+    if ( x > b1 || ( b0 > 0 && y < b0-1 ) )
+      return;
+    u8g2_draw_circle_hrun(u8g2, x0, y0, x, 0, y, option, b0, b1);
+    if ( x >= y )
+      break;
+    if (f >= 0) 
+    {
+      if ( y != x+1 )
+	u8g2_draw_circle_hrun(u8g2, x0, y0, y, 0, x, option, b0, b1);
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+  }
+}
+
+/*
+  Same loops as u8g2_draw_ellipse(). The first loop collects the steps with 
+  the same x (vertical runs, increasing rows), the second loop collects 
+  the steps with the same y (horizontal runs, decreasing rows).
+*/
+static void u8g2_draw_clipped_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
+{
+  u8g2_uint_t x, y;
+  u8g2_uint_t a;		/* start of the current run */
+  u8g2_long_t xchg, ychg;
+  u8g2_long_t err;
+  u8g2_long_t rxrx2;
+  u8g2_long_t ryry2;
+  u8g2_long_t stopx, stopy;
+  u8g2_uint_t b0, b1;
+  
+  if ( u8g2_get_circle_rows(u8g2, y0, option, &b0, &b1) == 0 )
+    return;
+  
+  rxrx2 = rx;
+  rxrx2 *= rx;
+  rxrx2 *= 2;
+  
+  ryry2 = ry;
+  ryry2 *= ry;
+  ryry2 *= 2;
+  
+  x = rx;
+  y = 0;
+  
+  xchg = 1;
+  xchg -= rx;
+  xchg -= rx;
+  xchg *= ry;
+  xchg *= ry;
+  
+  ychg = rx;
+  ychg *= rx;
+  
+  err = 0;
+  
+  stopx = ryry2;
+  stopx *= rx;
+  stopy = 0;
+  
+  a = 0;
+  while( stopx >= stopy )
+  {
+    y++;
+    stopy += rxrx2;
+    err += ychg;
+    ychg += rxrx2;
+    if ( 2*err+xchg > 0 )
+    {
+      /* x will change: draw the run from a to y-1 */
+      u8g2_draw_circle_vrun(u8g2, x0, y0, x, a, y-1, option, b0, b1);
+      a = y;
+      if ( a > b1 )
+	break;
+      x--;
+      stopx -= ryry2;
+      err += xchg;
+      xchg += ryry2;      
+    }
+    else if ( stopx < stopy )
+    {
+      u8g2_draw_circle_vrun(u8g2, x0, y0, x, a, y-1, option, b0, b1);
+    }
+  }
+
+  x = 0;
+  y = ry;
+  
+  xchg = ry;
+  xchg *= ry;
+  
+  ychg = 1;
+  ychg -= ry;
+  ychg -= ry;
+  ychg *= rx;
+  ychg *= rx;
+  
+  err = 0;
+  
+  stopx = 0;
+
+  stopy = rxrx2;
+  stopy *= ry;
+  
+  a = 0;
+  while( stopx <= stopy )
+  {
+    x++;
+    stopx += ryry2;
+    err += xchg;
+    xchg += ryry2;
+    if ( 2*err+ychg > 0 )
+    {
+      /* y will change: draw the run from a to x-1 */
+      u8g2_draw_circle_hrun(u8g2, x0, y0, y, a, x-1, option, b0, b1);
+      a = x;
+      if ( y <= b0 )
+	break;
+      y--;
+      stopy -= rxrx2;
+      err += ychg;
+      ychg += rxrx2;
+    }
+    else if ( stopx > stopy )
+    {
+      u8g2_draw_circle_hrun(u8g2, x0, y0, y, a, x-1, option, b0, b1);
+    }
+  }
+}
+
+/*
+  Same loops as u8g2_draw_filled_ellipse(), but the ellipse is drawn with 
+  one horizontal line per row:
+  The first loop has one step per row (increasing rows), the half width
+  is the x value of the step. The second loop (decreasing rows) has one or 
+  more steps per row, the half width is the last x of the row. 
+  The last x of the second loop is also the half width of all rows below. 
+  Rows of the second loop, which are already covered by the first loop,
+  are skipped. Only a few rows at the end of both loops are drawn twice.
+*/
+static void u8g2_draw_clipped_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
+{
+  u8g2_uint_t x, y;
+  u8g2_uint_t x1, y1;		/* last step of the first loop */
+  u8g2_long_t xchg, ychg;
+  u8g2_long_t err;
+  u8g2_long_t rxrx2;
+  u8g2_long_t ryry2;
+  u8g2_long_t stopx, stopy;
+  u8g2_uint_t b0, b1;
+  
+  if ( u8g2_get_circle_rows(u8g2, y0, option, &b0, &b1) == 0 )
+    return;
+  
+  rxrx2 = rx;
+  rxrx2 *= rx;
+  rxrx2 *= 2;
+  
+  ryry2 = ry;
+  ryry2 *= ry;
+  ryry2 *= 2;
+  
+  x = rx;
+  y = 0;
+  
+  xchg = 1;
+  xchg -= rx;
+  xchg -= rx;
+  xchg *= ry;
+  xchg *= ry;
+  
+  ychg = rx;
+  ychg *= rx;
+  
+  err = 0;
+  
+  stopx = ryry2;
+  stopx *= rx;
+  stopy = 0;
+  
+  /* all rows up to y1 have at least the half width x1 */
+  x1 = x;
+  y1 = y;
+  while( stopx >= stopy )
+  {
+    u8g2_draw_circle_hrun(u8g2, x0, y0, y, 0, x, option, b0, b1);
+    x1 = x;
+    y1 = y;
+    if ( y >= b1 )
+      break;
+    y++;
+    stopy += rxrx2;
+    err += ychg;
+    ychg += rxrx2;
+    if ( 2*err+xchg > 0 )
+    {
+      x--;
+      stopx -= ryry2;
+      err += xchg;
+      xchg += ryry2;      
+    }
+  }
+
+  x = 0;
+  y = ry;
+  
+  xchg = ry;
+  xchg *= ry;
+  
+  ychg = 1;
+  ychg -= ry;
+  ychg -= ry;
+  ychg *= rx;
+  ychg *= rx;
+  
+  err = 0;
+  
+  stopx = 0;
+
+  stopy = rxrx2;
+  stopy *= ry;
+  
+  while( stopx <= stopy )
+  {
+    x++;
+    stopx += ryry2;
+    err += xchg;
+    xchg += ryry2;
+    if ( 2*err+ychg > 0 )
+    {
+      /* y will change: the half width of row y is x-1 */
+      if ( y > y1 || x-1 > x1 )
+	u8g2_draw_circle_hrun(u8g2, x0, y0, y, 0, x-1, option, b0, b1);
+      if ( y <= b0 )
+	return;
+      y--;
+      stopy -= rxrx2;
+      err += ychg;
+      ychg += rxrx2;
+    }
+  }
+  
+  /* the last x of the second loop is the half width of row y and all rows below */
+  x--;
+  while( y >= b0 )
+  {
+    if ( y <= y1 && x <= x1 )
+      break;
+    u8g2_draw_circle_hrun(u8g2, x0, y0, y, 0, x, option, b0, b1);
+    if ( y == 0 )
+      break;
+    y--;
+  }
+}
+
+#endif /* U8G2_WITH_CLIPPED_CIRCLE */
+
 /*==============================================*/
 /* Circle */
 
@@ -115,6 +573,14 @@ void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t r
       return;
   }
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_CLIPPED_CIRCLE
+  if ( u8g2->draw_color != 2 )
+  {
+    u8g2_draw_clipped_circle(u8g2, x0, y0, rad, option);
+    return;
+  }
+#endif /* U8G2_WITH_CLIPPED_CIRCLE */
   
   
   /* draw circle */
@@ -201,6 +667,14 @@ void u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad
       return;
   }
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_CLIPPED_CIRCLE
+  if ( u8g2->draw_color != 2 )
+  {
+    u8g2_draw_clipped_disc(u8g2, x0, y0, rad, option);
+    return;
+  }
+#endif /* U8G2_WITH_CLIPPED_CIRCLE */
   
   /* draw disc */
   u8g2_draw_disc(u8g2, x0, y0, rad, option);
@@ -339,6 +813,14 @@ void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t
       return;
   }
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_CLIPPED_CIRCLE
+  if ( u8g2->draw_color != 2 )
+  {
+    u8g2_draw_clipped_ellipse(u8g2, x0, y0, rx, ry, option);
+    return;
+  }
+#endif /* U8G2_WITH_CLIPPED_CIRCLE */
   
   u8g2_draw_ellipse(u8g2, x0, y0, rx, ry, option);
 }
@@ -472,6 +954,14 @@ void u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_u
       return;
   }
 #endif /* U8G2_WITH_INTERSECTION */
+
+#ifdef U8G2_WITH_CLIPPED_CIRCLE
+  if ( u8g2->draw_color != 2 )
+  {
+    u8g2_draw_clipped_filled_ellipse(u8g2, x0, y0, rx, ry, option);
+    return;
+  }
+#endif /* U8G2_WITH_CLIPPED_CIRCLE */
   
   u8g2_draw_filled_ellipse(u8g2, x0, y0, rx, ry, option);
 }
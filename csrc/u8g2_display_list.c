@@ -0,0 +1,296 @@
+/*
+
+  u8g2_display_list.c
+
+  Record the output of all draw procedures once and replay it for each page
+  of the picture loop.
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+
+  In page mode, the draw procedures are executed once for each page.
+  Each primitive is clipped against each page and each glyph is decoded
+  again for each page.
+
+  The display list records the low level hvlines, which are generated
+  by the draw procedures (after clipping and rotation). Each hvline is
+  assigned to the page (bin), which contains the hvline. Vertical lines are
+  split at the page boundaries. During the picture loop only the hvlines of
+  the current page are sent to the low level hvline procedure.
+
+  Usage:
+
+    static uint16_t dl[1000];
+
+    u8g2_BeginDisplayList(&u8g2, dl, sizeof(dl)/sizeof(uint16_t));
+    draw();
+    if ( u8g2_EndDisplayList(&u8g2) )
+    {
+      u8g2_SendDisplayList(&u8g2);
+    }
+    else
+    {
+      // display list is too small, use the normal picture loop
+      u8g2_FirstPage(&u8g2);
+      do
+      {
+	draw();
+      } while( u8g2_NextPage(&u8g2) );
+    }
+
+  Memory layout of the display list (array of uint16_t):
+    2 words per page:	index of the first and the last entry of the page
+    4 words per entry:	next, x, y, len/dir/color
+
+  Limitations:
+    - Functions, which modify the dimension of u8g2 (u8g2_SetDisplayRotation,
+      u8g2_SetBufferCurrTileRow, u8g2_FirstPage, ...) must not be called
+      between u8g2_BeginDisplayList and u8g2_EndDisplayList.
+    - Direct modifications of the buffer are not recorded.
+    - The gray level of the 4 bit per pixel buffer is not recorded.
+
+*/
+
+#include "u8g2.h"
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+
+#define U8G2_DL_END 0x0ffff
+#define U8G2_DL_WORDS_PER_ENTRY 4
+#define U8G2_DL_LEN_MASK 0x0fff
+#define U8G2_DL_DIR_POS 12
+#define U8G2_DL_COLOR_POS 13
+
+static u8g2_uint_t u8g2_get_display_list_page_height(u8g2_t *u8g2)
+{
+  u8g2_uint_t page_height;
+  page_height = u8g2->tile_buf_height;
+  page_height *= 8;
+  return page_height;
+}
+
+static void u8g2_add_display_list_entry(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir, uint8_t page)
+{
+  uint16_t *dl = u8g2->dl_ptr;
+  uint16_t pos = u8g2->dl_pos;
+
+  if ( u8g2->dl_is_overflow != 0 )
+    return;
+  if ( pos + U8G2_DL_WORDS_PER_ENTRY > u8g2->dl_size )
+  {
+    u8g2->dl_is_overflow = 1;
+    return;
+  }
+
+  dl[pos] = U8G2_DL_END;
+  dl[pos+1] = x;
+  dl[pos+2] = y;
+  dl[pos+3] = (len & U8G2_DL_LEN_MASK) | (((uint16_t)dir) << U8G2_DL_DIR_POS) | (((uint16_t)u8g2->draw_color) << U8G2_DL_COLOR_POS);
+
+  /* append the entry to the list of the page, this will preserve the draw order */
+  if ( dl[page*2] == U8G2_DL_END )
+    dl[page*2] = pos;
+  else
+    dl[dl[page*2+1]] = pos;
+  dl[page*2+1] = pos;
+
+  u8g2->dl_pos = pos + U8G2_DL_WORDS_PER_ENTRY;
+}
+
+/*
+  replacement for the low level hvline procedure during recording
+  x,y are display coordinates, because pixel_curr_row is zero
+*/
+static void u8g2_ll_hvline_display_list(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_uint_t page_height = u8g2_get_display_list_page_height(u8g2);
+  u8g2_uint_t page_y1;
+  u8g2_uint_t l;
+  uint8_t page;
+
+  if ( dir == 0 )
+  {
+    u8g2_add_display_list_entry(u8g2, x, y, len, 0, y / page_height);
+  }
+  else
+  {
+    /* split vertical lines at the page boundary */
+    do
+    {
+      page = y / page_height;
+      page_y1 = page_height;
+      page_y1 *= page+1;
+      l = page_y1 - y;
+      if ( l > len )
+	l = len;
+      u8g2_add_display_list_entry(u8g2, x, y, l, 1, page);
+      y += l;
+      len -= l;
+    } while( len != 0 );
+  }
+}
+
+/*
+  Start recording of all draw procedures.
+  buf:		memory for the display list
+  size:		number of uint16_t words in buf.
+		The display list requires 2 words per page and 4 words per hvline.
+*/
+void u8g2_BeginDisplayList(u8g2_t *u8g2, uint16_t *buf, uint16_t size)
+{
+  uint8_t tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  uint8_t page_cnt;
+  uint16_t i;
+
+  page_cnt = (tile_height + u8g2->tile_buf_height - 1) / u8g2->tile_buf_height;
+
+  u8g2->dl_ptr = buf;
+  u8g2->dl_size = size;
+  u8g2->dl_page_cnt = page_cnt;
+  u8g2->dl_pos = page_cnt*2;
+  u8g2->dl_is_overflow = 0;
+  if ( u8g2->dl_pos > size )
+  {
+    u8g2->dl_is_overflow = 1;
+  }
+  else
+  {
+    for( i = 0; i < page_cnt*2; i++ )
+      buf[i] = U8G2_DL_END;
+  }
+
+  /* replace the low level procedure */
+  u8g2->dl_ll_hvline = u8g2->ll_hvline;
+  u8g2->ll_hvline = u8g2_ll_hvline_display_list;
+
+  /* the complete display is visible during recording */
+  u8g2->pixel_curr_row = 0;
+  u8g2->buf_y0 = 0;
+  u8g2->buf_y1 = tile_height;
+  u8g2->buf_y1 *= 8;
+  u8g2->cb->update_page_win(u8g2);
+}
+
+/*
+  Stop recording.
+  Returns 0 if the display list was too small. In this case u8g2_DrawDisplayList()
+  will not draw anything.
+*/
+uint8_t u8g2_EndDisplayList(u8g2_t *u8g2)
+{
+  u8g2->ll_hvline = u8g2->dl_ll_hvline;
+  u8g2->dl_ll_hvline = NULL;
+
+  /* restore dimension and page window for the current tile row */
+  u8g2_SetBufferCurrTileRow(u8g2, u8g2->tile_curr_row);
+
+  if ( u8g2->dl_is_overflow != 0 )
+  {
+    u8g2->dl_page_cnt = 0;
+    return 0;
+  }
+  return 1;
+}
+
+/*
+  Draw all recorded hvlines, which are visible in the current page.
+  This procedure must be called inside the picture loop.
+*/
+void u8g2_DrawDisplayList(u8g2_t *u8g2)
+{
+  uint16_t *dl = u8g2->dl_ptr;
+  u8g2_uint_t page_height = u8g2_get_display_list_page_height(u8g2);
+  u8g2_uint_t x, y, len;
+  uint16_t pos;
+  uint8_t page, page_end;
+  uint8_t dir;
+  uint8_t draw_color = u8g2->draw_color;
+
+  if ( u8g2->dl_page_cnt == 0 )
+    return;
+
+  /* usually this is exactly one page, but the buffer might not be aligned to the recorded pages */
+  page = u8g2->buf_y0 / page_height;
+  page_end = (u8g2->buf_y1 - 1) / page_height;
+  if ( page_end >= u8g2->dl_page_cnt )
+    page_end = u8g2->dl_page_cnt - 1;
+
+  for(;;)
+  {
+    pos = dl[page*2];
+    while( pos != U8G2_DL_END )
+    {
+      x = dl[pos+1];
+      y = dl[pos+2];
+      len = dl[pos+3] & U8G2_DL_LEN_MASK;
+      dir = (dl[pos+3] >> U8G2_DL_DIR_POS) & 1;
+      u8g2->draw_color = dl[pos+3] >> U8G2_DL_COLOR_POS;
+      pos = dl[pos];
+
+      /* clip against the current buffer */
+      if ( dir == 0 )
+      {
+	if ( y < u8g2->buf_y0 || y >= u8g2->buf_y1 )
+	  continue;
+      }
+      else
+      {
+	if ( y < u8g2->buf_y0 )
+	{
+	  if ( y + len <= u8g2->buf_y0 )
+	    continue;
+	  len -= u8g2->buf_y0 - y;
+	  y = u8g2->buf_y0;
+	}
+	if ( y >= u8g2->buf_y1 )
+	  continue;
+	if ( len > u8g2->buf_y1 - y )
+	  len = u8g2->buf_y1 - y;
+      }
+      u8g2->ll_hvline(u8g2, x, y - u8g2->pixel_curr_row, len, dir);
+    }
+    if ( page >= page_end )
+      break;
+    page++;
+  }
+  u8g2->draw_color = draw_color;
+}
+
+/* picture loop, which draws the display list */
+void u8g2_SendDisplayList(u8g2_t *u8g2)
+{
+  u8g2_FirstPage(u8g2);
+  do
+  {
+    u8g2_DrawDisplayList(u8g2);
+  } while( u8g2_NextPage(u8g2) );
+}
+
+#endif /* U8G2_WITH_DISPLAY_LIST */
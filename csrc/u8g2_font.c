@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 /* size of the font data structure, there is no struct or class... */
 /* this is the size for the new font format */
@@ -482,6 +483,119 @@ void u8g2_font_decode_len(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
 }
 
 
+#ifdef U8G2_WITH_DIRECT_GLYPH_DRAW
+/*
+  Description:
+    Same as u8g2_font_decode_len(), but write the pixel directly into the tile buffer.
+    The glyph must be completly inside the current page and clip window. 
+    Only font direction 0 and U8G2_R0 is supported.
+  Args:
+    u8g2->font_decode.target_x		X position
+    u8g2->font_decode.target_y		Y position within the tile buffer (pixel_curr_row is already subtracted)
+*/
+static void u8g2_font_decode_len_direct(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t cnt = len;
+  uint8_t rem;
+  uint8_t current;
+  uint8_t lx = decode->x;
+  uint8_t ly = decode->y;
+  uint8_t color;
+  uint8_t mask, or_mask, xor_mask;
+  uint16_t offset;
+  uint8_t *ptr;
+  u8g2_uint_t x, y;
+  
+  color = decode->fg_color;
+  if ( is_foreground == 0 )
+    color = decode->bg_color;
+  
+  for(;;)
+  {
+    rem = decode->glyph_width;
+    rem -= lx;
+    current = rem;
+    if ( cnt < rem )
+      current = cnt;
+    
+    if ( current != 0 && ly < (uint8_t)decode->glyph_height && (is_foreground || decode->is_transparent == 0) )
+    {
+      x = decode->target_x + lx;
+      y = decode->target_y + ly;
+      if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+      {
+	/* see u8g2_ll_hvline_vertical_top_lsb() */
+	mask = 1;
+	mask <<= y & 7;
+	or_mask = 0;
+	xor_mask = 0;
+	if ( color <= 1 )
+	  or_mask  = mask;
+	if ( color != 1 )
+	  xor_mask = mask;
+	offset = y;
+	offset &= ~7;
+	offset *= u8g2_GetBufferTileWidth(u8g2);
+	ptr = u8g2->tile_buf_ptr + offset + x;
+	do
+	{
+	  *ptr |= or_mask;
+	  *ptr ^= xor_mask;
+	  ptr++;
+	  current--;
+	} while( current != 0 );
+      }
+      else
+      {
+	u8g2->draw_color = color;		/* draw_color will be restored later */
+	u8g2_ll_hvline_horizontal_right_lsb(u8g2, x, y, current, 0);
+      }
+    }
+    
+    if ( cnt < rem )
+      break;
+    cnt -= rem;
+    lx = 0;
+    ly++;
+  }
+  lx += cnt;
+  
+  decode->x = lx;
+  decode->y = ly;  
+}
+
+/* check whether the glyph can be drawn with u8g2_font_decode_len_direct() */
+static uint8_t u8g2_font_is_direct_decode(u8g2_t *u8g2)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  u8g2_uint_t x1, y1;
+  
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( decode->dir != 0 )
+    return 0;
+#endif
+  if ( u8g2->cb->draw_l90 != u8g2_draw_l90_r0 )
+    return 0;
+  /* the buffer might be replaced, for example by the display list */
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb && u8g2->ll_hvline != u8g2_ll_hvline_horizontal_right_lsb )
+    return 0;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return 0;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  
+  /* the glyph must be completly inside the visible area */
+  x1 = decode->target_x + decode->glyph_width;
+  y1 = decode->target_y + decode->glyph_height;
+  if ( decode->target_x < u8g2->user_x0 || x1 > u8g2->user_x1 || x1 < decode->target_x )
+    return 0;
+  if ( decode->target_y < u8g2->user_y0 || y1 > u8g2->user_y1 || y1 < decode->target_y )
+    return 0;
+  return 1;
+}
+#endif /* U8G2_WITH_DIRECT_GLYPH_DRAW */
+
 void u8g2_font_2x_decode_len(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
 {
   uint8_t cnt;	/* total number of remaining pixels, which have to be drawn */
@@ -688,6 +802,29 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
     decode->x = 0;
     decode->y = 0;
     
+#ifdef U8G2_WITH_DIRECT_GLYPH_DRAW
+    if ( u8g2_font_is_direct_decode(u8g2) )
+    {
+      /* transform to pixel buffer coordinates */
+      decode->target_y -= u8g2->pixel_curr_row;
+      for(;;)
+      {
+	a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+	b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+	do
+	{
+	  u8g2_font_decode_len_direct(u8g2, a, 0);
+	  u8g2_font_decode_len_direct(u8g2, b, 1);
+	} while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+
+	if ( decode->y >= h )
+	  break;
+      }
+      u8g2->draw_color = decode->fg_color;
+      return d;
+    }
+#endif /* U8G2_WITH_DIRECT_GLYPH_DRAW */
+    
     /* decode glyph */
     for(;;)
     {
@@ -771,6 +908,157 @@ int8_t u8g2_font_2x_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   return d*2;
 }
 
+#ifdef U8G2_WITH_FONT_INDEX
+/*
+  Glyph index (array of uint32_t), built by u8g2_SetFont():
+    idx[0..255]		offset of the glyph data of the 8 bit glyphs, 0 if the glyph is not available
+    idx[256]		number of unicode index entries
+    idx[257]		number of unicode glyphs per index entry, 0 if the unicode glyphs are not indexed
+    idx[258...]		pairs of unicode encoding and offset of the unicode glyph
+  All offsets are relative to the start of the font.
+  If the buffer is too small for all unicode glyphs, only every n-th glyph
+  is added to the index and the remaining glyphs are found by a short linear search.
+*/
+static void u8g2_build_font_index(u8g2_t *u8g2)
+{
+  const uint8_t *font = u8g2->font;
+  const uint8_t *p;
+  uint32_t *idx = u8g2->font_index_ptr;
+  uint16_t i;
+
+  u8g2->font_index_font = NULL;
+  if ( idx == NULL || font == NULL || u8g2->font_index_size < U8G2_FONT_INDEX_SIZE(0) )
+    return;
+  
+  for( i = 0; i < 256; i++ )
+    idx[i] = 0;
+  idx[256] = 0;
+  idx[257] = 0;
+  
+  p = font + U8G2_FONT_DATA_STRUCT_SIZE;
+  for(;;)
+  {
+    if ( u8x8_pgm_read( p + 1 ) == 0 )
+      break;
+    if ( idx[u8x8_pgm_read( p )] == 0 )
+      idx[u8x8_pgm_read( p )] = (uint32_t)(p + 2 - font);
+    p += u8x8_pgm_read( p + 1 );
+  }
+
+#ifdef U8G2_WITH_UNICODE
+  {
+    const uint8_t *unicode_start;
+    size_t glyph_cnt, entry_max, stride, n, j;
+    uint32_t *entry;
+
+    unicode_start = font + U8G2_FONT_DATA_STRUCT_SIZE + u8g2->font_info.start_pos_unicode;
+    /* the first glyph follows the unicode lookup table */
+    unicode_start += u8g2_font_get_word(unicode_start, 0);
+    
+    glyph_cnt = 0;
+    for( p = unicode_start; u8x8_pgm_read( p ) != 0 || u8x8_pgm_read( p + 1 ) != 0; p += u8x8_pgm_read( p + 2 ) )
+      glyph_cnt++;
+    
+    entry_max = (u8g2->font_index_size - U8G2_FONT_INDEX_SIZE(0)) / 2;
+    if ( glyph_cnt > 0 && entry_max == 0 )
+    {
+      /* no space for the unicode glyphs, use the linear search */
+      u8g2->font_index_font = font;
+      return;
+    }
+    
+    stride = 1;
+    if ( glyph_cnt > entry_max )
+      stride = (glyph_cnt + entry_max - 1) / entry_max;
+    
+    n = 0;
+    j = 0;
+    entry = idx + U8G2_FONT_INDEX_SIZE(0);
+    for( p = unicode_start; u8x8_pgm_read( p ) != 0 || u8x8_pgm_read( p + 1 ) != 0; p += u8x8_pgm_read( p + 2 ) )
+    {
+      if ( j == 0 )
+      {
+	entry[0] = ((uint16_t)u8x8_pgm_read( p ) << 8) | u8x8_pgm_read( p + 1 );
+	entry[1] = (uint32_t)(p - font);
+	entry += 2;
+	n++;
+	j = stride;
+      }
+      j--;
+    }
+    idx[256] = (uint32_t)n;
+    idx[257] = (uint32_t)stride;
+  }
+#endif /* U8G2_WITH_UNICODE */
+  
+  u8g2->font_index_font = font;
+}
+
+/*
+  Assign a buffer for the glyph index of the current font. The index is 
+  rebuilt by u8g2_SetFont() whenever the font changes.
+  size is the number of uint32_t words of buf, see U8G2_FONT_INDEX_SIZE().
+  Use buf = NULL to disable the glyph index.
+*/
+void u8g2_SetFontIndexBuffer(u8g2_t *u8g2, uint32_t *buf, size_t size)
+{
+  u8g2->font_index_ptr = buf;
+  u8g2->font_index_size = size;
+  u8g2_build_font_index(u8g2);
+}
+
+/* returns the glyph data from the index or NULL, if the encoding is not available */
+static const uint8_t *u8g2_font_get_indexed_glyph_data(u8g2_t *u8g2, uint16_t encoding)
+{
+  const uint8_t *font = u8g2->font;
+  const uint32_t *idx = u8g2->font_index_ptr;
+  
+  if ( encoding <= 255 )
+  {
+    if ( idx[encoding] == 0 )
+      return NULL;
+    return font + idx[encoding];
+  }
+#ifdef U8G2_WITH_UNICODE
+  else
+  {
+    const uint32_t *entry = idx + U8G2_FONT_INDEX_SIZE(0);
+    size_t lo, hi, mid;
+    uint16_t e;
+    
+    /* binary search for the last entry with an encoding less or equal to the requested encoding */
+    lo = 0;
+    hi = idx[256];
+    while( lo < hi )
+    {
+      mid = (lo + hi) / 2;
+      if ( entry[mid*2] <= encoding )
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+    if ( lo == 0 )
+      return NULL;
+    font += entry[(lo-1)*2+1];
+    
+    /* the requested glyph is at most idx[257]-1 glyphs away */
+    for(;;)
+    {
+      e = u8x8_pgm_read( font );
+      e <<= 8;
+      e |= u8x8_pgm_read( font + 1 );
+      if ( e == 0 || e > encoding )
+	break;
+      if ( e == encoding )
+	return font+3;	/* skip encoding and glyph size */
+      font += u8x8_pgm_read( font + 2 );
+    }
+  }
+#endif
+  return NULL;
+}
+#endif /* U8G2_WITH_FONT_INDEX */
+
 /*
   Description:
     Find the starting point of the glyph data.
@@ -782,6 +1070,15 @@ int8_t u8g2_font_2x_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
 const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
 {
   const uint8_t *font = u8g2->font;
+  
+#ifdef U8G2_WITH_FONT_INDEX
+  if ( u8g2->font_index_font == font && font != NULL )
+  {
+    if ( encoding <= 255 || u8g2->font_index_ptr[257] != 0 )
+      return u8g2_font_get_indexed_glyph_data(u8g2, encoding);
+  }
+#endif /* U8G2_WITH_FONT_INDEX */
+  
   font += U8G2_FONT_DATA_STRUCT_SIZE;
 
   
@@ -866,9 +1163,500 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
   return NULL;
 }
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+/*========================================================================*/
+/* glyph cache */
+
+/*
+  The glyph cache stores decoded glyphs in the memory area, which is assigned 
+  with u8g2_SetGlyphCache(). Each entry is a u8g2_glyph_cache_entry_t followed by the 
+  bitmap of the glyph. The font direction is already applied to the bitmap and 
+  the bitmap has the same byte layout as the tile buffer:
+    vertical:	(h+7)/8 rows with w bytes each, lsb is the top pixel (u8g2_ll_hvline_vertical_top_lsb)
+    horizontal:	h rows with (w+7)/8 bytes each, msb is the left pixel (u8g2_ll_hvline_horizontal_right_lsb)
+  If there is no more space, the least recently used entries are removed.
+*/
+
+struct _u8g2_glyph_cache_entry_t
+{
+  const uint8_t *font;
+  uint16_t encoding;
+  uint16_t size;		/* size of the entry including the bitmap */
+  uint16_t last_use;		/* value of glyph_cache_clock at the last access */
+  int16_t x, y;		/* upper left corner of the bitmap, relative to the reference point of the glyph */
+  uint8_t w, h;			/* size of the bitmap in pixel, w is 0 for empty glyphs */
+  int8_t delta;			/* delta x advance of the glyph */
+  uint8_t dir;
+  uint8_t is_vertical;		/* byte layout of the bitmap */
+};
+typedef struct _u8g2_glyph_cache_entry_t u8g2_glyph_cache_entry_t;
+
+#define U8G2_GLYPH_CACHE_ALIGN (sizeof(void *))
+
+#ifdef U8G2_WITH_FONT_ROTATION
+#define u8g2_glyph_cache_dir(u8g2) ((u8g2)->font_decode.dir)
+#else
+#define u8g2_glyph_cache_dir(u8g2) 0
+#endif
+
+static uint8_t *u8g2_glyph_cache_bitmap(u8g2_glyph_cache_entry_t *e)
+{
+  return ((uint8_t *)e) + sizeof(u8g2_glyph_cache_entry_t);
+}
+
+static uint16_t u8g2_glyph_cache_bitmap_size(uint8_t w, uint8_t h, uint8_t is_vertical)
+{
+  if ( is_vertical )
+    return (uint16_t)w*(uint16_t)((h+7)/8);
+  return (uint16_t)h*(uint16_t)((w+7)/8);
+}
+
+/*
+  Assign a memory area for the glyph cache. The cache is disabled if buf is NULL.
+  Each glyph requires about 20 bytes plus the size of the bitmap.
+*/
+void u8g2_SetGlyphCache(u8g2_t *u8g2, void *buf, size_t size)
+{
+  uint8_t *ptr = (uint8_t *)buf;
+  size_t misalignment;
+  
+  /* entries contain a pointer, so start at an aligned address */
+  misalignment = (size_t)((uintptr_t)ptr % U8G2_GLYPH_CACHE_ALIGN);
+  if ( ptr != NULL && misalignment != 0 )
+  {
+    misalignment = U8G2_GLYPH_CACHE_ALIGN - misalignment;
+    if ( size < misalignment )
+      size = misalignment;
+    ptr += misalignment;
+    size -= misalignment;
+  }
+  u8g2->glyph_cache_ptr = ptr;
+  u8g2->glyph_cache_size = size;
+  u8g2->glyph_cache_used = 0;
+  u8g2->glyph_cache_clock = 0;
+}
+
+/* remove all glyphs from the cache, required if a font in RAM is modified */
+void u8g2_ClearGlyphCache(u8g2_t *u8g2)
+{
+  u8g2->glyph_cache_used = 0;
+}
+
+static void u8g2_glyph_cache_touch(u8g2_t *u8g2, u8g2_glyph_cache_entry_t *e)
+{
+  size_t pos;
+  
+  u8g2->glyph_cache_clock++;
+  if ( u8g2->glyph_cache_clock == 0 )
+  {
+    /* overflow: restart the clock for all entries */
+    for( pos = 0; pos < u8g2->glyph_cache_used; pos += ((u8g2_glyph_cache_entry_t *)(u8g2->glyph_cache_ptr+pos))->size )
+      ((u8g2_glyph_cache_entry_t *)(u8g2->glyph_cache_ptr+pos))->last_use = 0;
+    u8g2->glyph_cache_clock = 1;
+  }
+  e->last_use = u8g2->glyph_cache_clock;
+}
+
+static u8g2_glyph_cache_entry_t *u8g2_glyph_cache_find(u8g2_t *u8g2, uint16_t encoding, uint8_t dir, uint8_t is_vertical)
+{
+  u8g2_glyph_cache_entry_t *e;
+  size_t pos;
+  
+  for( pos = 0; pos < u8g2->glyph_cache_used; pos += e->size )
+  {
+    e = (u8g2_glyph_cache_entry_t *)(u8g2->glyph_cache_ptr+pos);
+    if ( e->encoding == encoding && e->font == u8g2->font && e->dir == dir && e->is_vertical == is_vertical )
+      return e;
+  }
+  return NULL;
+}
+
+/* remove the least recently used entry and move all other entries down */
+static void u8g2_glyph_cache_remove_lru(u8g2_t *u8g2)
+{
+  u8g2_glyph_cache_entry_t *e;
+  size_t pos, lru_pos;
+  uint16_t lru_size;
+  uint16_t lru_last_use;
+  
+  lru_pos = 0;
+  lru_size = 0;
+  lru_last_use = 0x0ffff;
+  for( pos = 0; pos < u8g2->glyph_cache_used; pos += e->size )
+  {
+    e = (u8g2_glyph_cache_entry_t *)(u8g2->glyph_cache_ptr+pos);
+    if ( e->last_use <= lru_last_use )
+    {
+      lru_pos = pos;
+      lru_size = e->size;
+      lru_last_use = e->last_use;
+    }
+  }
+  memmove(u8g2->glyph_cache_ptr+lru_pos, u8g2->glyph_cache_ptr+lru_pos+lru_size, u8g2->glyph_cache_used-lru_pos-lru_size);
+  u8g2->glyph_cache_used -= lru_size;
+}
+
+static void u8g2_glyph_cache_set_pixel(u8g2_glyph_cache_entry_t *e, uint8_t x, uint8_t y)
+{
+  uint8_t *bitmap = u8g2_glyph_cache_bitmap(e);
+  if ( e->is_vertical )
+    bitmap[(y>>3)*(uint16_t)e->w + x] |= 1<<(y&7);
+  else
+    bitmap[y*(uint16_t)((e->w+7)>>3) + (x>>3)] |= 128>>(x&7);
+}
+
+static uint8_t u8g2_glyph_cache_get_pixel(u8g2_glyph_cache_entry_t *e, uint8_t x, uint8_t y)
+{
+  uint8_t *bitmap = u8g2_glyph_cache_bitmap(e);
+  if ( e->is_vertical )
+    return (bitmap[(y>>3)*(uint16_t)e->w + x] >> (y&7)) & 1;
+  return (bitmap[y*(uint16_t)((e->w+7)>>3) + (x>>3)] >> (7-(x&7))) & 1;
+}
+
+/*
+  Decode the glyph and add it to the cache. 
+  Returns NULL if the glyph does not fit into the cache.
+*/
+static u8g2_glyph_cache_entry_t *u8g2_glyph_cache_add(u8g2_t *u8g2, const uint8_t *glyph_data, uint16_t encoding, uint8_t dir, uint8_t is_vertical)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  u8g2_glyph_cache_entry_t *e;
+  uint8_t a, b, w, h, lx, ly;
+  int8_t x, y, d;
+  int16_t ox, oy;
+  uint8_t cnt;
+  size_t size;
+  
+  u8g2_font_setup_decode(u8g2, glyph_data);
+  w = decode->glyph_width;
+  h = decode->glyph_height;
+  x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+  y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+  d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+  if ( w == 0 )
+    h = 0;
+  
+  size = sizeof(u8g2_glyph_cache_entry_t);
+  size += u8g2_glyph_cache_bitmap_size(dir & 1 ? h : w, dir & 1 ? w : h, is_vertical);
+  size += U8G2_GLYPH_CACHE_ALIGN-1;
+  size -= size % U8G2_GLYPH_CACHE_ALIGN;
+  if ( size > u8g2->glyph_cache_size )
+    return NULL;
+  while( u8g2->glyph_cache_used + size > u8g2->glyph_cache_size )
+    u8g2_glyph_cache_remove_lru(u8g2);
+  
+  e = (u8g2_glyph_cache_entry_t *)(u8g2->glyph_cache_ptr+u8g2->glyph_cache_used);
+  u8g2->glyph_cache_used += size;
+  memset(e, 0, size);
+  e->font = u8g2->font;
+  e->encoding = encoding;
+  e->size = size;
+  e->delta = d;
+  e->dir = dir;
+  e->is_vertical = is_vertical;
+  u8g2_glyph_cache_touch(u8g2, e);
+  
+  if ( w == 0 )
+    return e;
+  
+  /* upper left corner of the glyph, see u8g2_font_decode_glyph() */
+  ox = x;
+  oy = -(h+y);
+  /* rotate the glyph box around the reference point */
+  switch(dir)
+  {
+    case 0: e->x = ox; e->y = oy; break;
+    case 1: e->x = -oy-h+1; e->y = ox; break;
+    case 2: e->x = -ox-w+1; e->y = -oy-h+1; break;
+    default: e->x = oy; e->y = -ox-w+1; break;
+  }
+  e->w = dir & 1 ? h : w;
+  e->h = dir & 1 ? w : h;
+  
+  /* decode the glyph into the bitmap, see u8g2_font_decode_glyph() and u8g2_font_decode_len() */
+  lx = 0;
+  ly = 0;
+  for(;;)
+  {
+    a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+    b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+    do
+    {
+      lx += a;
+      while( lx >= w )
+      {
+	lx -= w;
+	ly++;
+      }
+      for( cnt = b; cnt > 0; cnt-- )
+      {
+	if ( ly < h )
+	{
+	  switch(dir)
+	  {
+	    case 0: u8g2_glyph_cache_set_pixel(e, lx, ly); break;
+	    case 1: u8g2_glyph_cache_set_pixel(e, h-1-ly, lx); break;
+	    case 2: u8g2_glyph_cache_set_pixel(e, w-1-lx, h-1-ly); break;
+	    default: u8g2_glyph_cache_set_pixel(e, ly, w-1-lx); break;
+	  }
+	}
+	lx++;
+	if ( lx >= w )
+	{
+	  lx = 0;
+	  ly++;
+	}
+      }
+    } while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+
+    if ( ly >= h )
+      break;
+  }
+  return e;
+}
+
+/* apply the draw color to the pixels in mask, see u8g2_ll_hvline_vertical_top_lsb() */
+static void u8g2_glyph_cache_apply(uint8_t *ptr, uint8_t mask, uint8_t color)
+{
+  if ( color <= 1 )
+    *ptr |= mask;
+  if ( color != 1 )
+    *ptr ^= mask;
+}
+
+/* draw the cached glyph with a sequence of hvlines, this will work for all rotations and buffers */
+static void u8g2_glyph_cache_draw_hvlines(u8g2_t *u8g2, u8g2_glyph_cache_entry_t *e, u8g2_uint_t x, u8g2_uint_t y, uint8_t fg_color, uint8_t bg_color)
+{
+  uint8_t bx, by, start, pixel;
+  
+  for( by = 0; by < e->h; by++ )
+  {
+    bx = 0;
+    while( bx < e->w )
+    {
+      start = bx;
+      pixel = u8g2_glyph_cache_get_pixel(e, bx, by);
+      do
+      {
+	bx++;
+      } while( bx < e->w && u8g2_glyph_cache_get_pixel(e, bx, by) == pixel );
+      
+      if ( pixel )
+	u8g2->draw_color = fg_color;
+      else if ( u8g2->font_decode.is_transparent == 0 )
+	u8g2->draw_color = bg_color;
+      else
+	continue;
+      u8g2_DrawHVLine(u8g2, x+start, y+by, bx-start, 0);
+    }
+  }
+  u8g2->draw_color = fg_color;
+}
+
+/* 
+  copy the cached glyph into a vertical_top_lsb tile buffer
+  x0, y0: upper left corner of the bitmap
+  cx0..cx1, cy0..cy1: visible part of the bitmap
+*/
+static void u8g2_glyph_cache_draw_vertical(u8g2_t *u8g2, u8g2_glyph_cache_entry_t *e, u8g2_uint_t x0, u8g2_uint_t y0, 
+  u8g2_uint_t cx0, u8g2_uint_t cy0, u8g2_uint_t cx1, u8g2_uint_t cy1, uint8_t fg_color, uint8_t bg_color)
+{
+  uint8_t *bitmap = u8g2_glyph_cache_bitmap(e);
+  uint8_t *ptr;
+  uint8_t *col;
+  uint8_t bits, mask;
+  uint8_t rows = (e->h+7)>>3;
+  uint8_t shift;
+  uint8_t is_transparent = u8g2->font_decode.is_transparent;
+  int16_t gy;		/* first glyph row of the current buffer byte */
+  uint8_t i;
+  u8g2_uint_t x, y, y_end;
+  
+  /* buffer coordinates */
+  cy0 -= u8g2->pixel_curr_row;
+  cy1 -= u8g2->pixel_curr_row;
+  y0 -= u8g2->pixel_curr_row;
+  
+  for( y = cy0 & ~7; y < cy1; y += 8 )
+  {
+    /* visible rows of this buffer byte */
+    mask = 255;
+    if ( y < cy0 )
+      mask <<= cy0 - y;
+    y_end = y + 8;
+    if ( y_end > cy1 )
+      mask &= 255 >> (y_end - cy1);
+    
+    gy = (int16_t)y - (int16_t)y0;
+    i = 0;
+    shift = 0;
+    if ( gy >= 0 )
+    {
+      i = gy >> 3;
+      shift = gy & 7;
+    }
+    
+    ptr = u8g2->tile_buf_ptr + (y>>3)*(uint16_t)u8g2->pixel_buf_width + cx0;
+    col = bitmap + i*(uint16_t)e->w + (cx0 - x0);
+    for( x = cx0; x < cx1; x++ )
+    {
+      if ( gy < 0 )
+      {
+	bits = *col << -gy;
+      }
+      else
+      {
+	bits = *col >> shift;
+	if ( shift != 0 && i+1 < rows )
+	  bits |= col[e->w] << (8-shift);
+      }
+      u8g2_glyph_cache_apply(ptr, bits & mask, fg_color);
+      if ( is_transparent == 0 )
+	u8g2_glyph_cache_apply(ptr, ~bits & mask, bg_color);
+      ptr++;
+      col++;
+    }
+  }
+}
+
+/* copy the cached glyph into a horizontal_right_lsb tile buffer */
+static void u8g2_glyph_cache_draw_horizontal(u8g2_t *u8g2, u8g2_glyph_cache_entry_t *e, u8g2_uint_t x0, u8g2_uint_t y0, 
+  u8g2_uint_t cx0, u8g2_uint_t cy0, u8g2_uint_t cx1, u8g2_uint_t cy1, uint8_t fg_color, uint8_t bg_color)
+{
+  uint8_t *bitmap = u8g2_glyph_cache_bitmap(e);
+  uint8_t *ptr;
+  uint8_t *row;
+  uint8_t bits, mask;
+  uint8_t bytes_per_row = (e->w+7)>>3;
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t is_transparent = u8g2->font_decode.is_transparent;
+  int16_t gx;		/* first glyph column of the current buffer byte */
+  uint8_t i, shift;
+  u8g2_uint_t x, y, x_end;
+  
+  for( y = cy0; y < cy1; y++ )
+  {
+    row = bitmap + (y - y0)*(uint16_t)bytes_per_row;
+    ptr = u8g2->tile_buf_ptr + (y - u8g2->pixel_curr_row)*(uint16_t)tile_width + (cx0>>3);
+    for( x = cx0 & ~7; x < cx1; x += 8 )
+    {
+      /* visible columns of this buffer byte */
+      mask = 255;
+      if ( x < cx0 )
+	mask >>= cx0 - x;
+      x_end = x + 8;
+      if ( x_end > cx1 )
+	mask &= 255 << (x_end - cx1);
+      
+      gx = (int16_t)x - (int16_t)x0;
+      if ( gx < 0 )
+      {
+	bits = row[0] >> -gx;
+      }
+      else
+      {
+	i = gx >> 3;
+	shift = gx & 7;
+	bits = row[i] << shift;
+	if ( shift != 0 && i+1 < bytes_per_row )
+	  bits |= row[i+1] >> (8-shift);
+      }
+      u8g2_glyph_cache_apply(ptr, bits & mask, fg_color);
+      if ( is_transparent == 0 )
+	u8g2_glyph_cache_apply(ptr, ~bits & mask, bg_color);
+      ptr++;
+    }
+  }
+}
+
+static void u8g2_glyph_cache_draw(u8g2_t *u8g2, u8g2_glyph_cache_entry_t *e, u8g2_uint_t x, u8g2_uint_t y)
+{
+  uint8_t fg_color = u8g2->draw_color;
+  uint8_t bg_color = (fg_color == 0 ? 1 : 0);
+  u8g2_uint_t x1, y1, cx0, cy0, cx1, cy1;
+  
+  if ( e->w == 0 )
+    return;
+  
+  x += e->x;
+  y += e->y;
+  x1 = x + e->w;
+  y1 = y + e->h;
+  
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x1, y1) == 0 ) 
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+  
+  /* direct copy into the tile buffer: only without display rotation and if the bitmap does not wrap around */
+  if ( u8g2->cb->draw_l90 == u8g2_draw_l90_r0 && x < x1 && y < y1 
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+    && u8g2->is_page_clip_window_intersection != 0
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+    )
+  {
+    cx0 = x < u8g2->user_x0 ? u8g2->user_x0 : x;
+    cy0 = y < u8g2->user_y0 ? u8g2->user_y0 : y;
+    cx1 = x1 > u8g2->user_x1 ? u8g2->user_x1 : x1;
+    cy1 = y1 > u8g2->user_y1 ? u8g2->user_y1 : y1;
+    if ( cx0 >= cx1 || cy0 >= cy1 )
+      return;
+    if ( e->is_vertical && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+    {
+      u8g2_glyph_cache_draw_vertical(u8g2, e, x, y, cx0, cy0, cx1, cy1, fg_color, bg_color);
+      return;
+    }
+    if ( e->is_vertical == 0 && u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+    {
+      u8g2_glyph_cache_draw_horizontal(u8g2, e, x, y, cx0, cy0, cx1, cy1, fg_color, bg_color);
+      return;
+    }
+  }
+  u8g2_glyph_cache_draw_hvlines(u8g2, e, x, y, fg_color, bg_color);
+}
+
+/*
+  Draw the glyph from the cache. The glyph is decoded and added to the cache if required.
+  Returns 0 if the glyph is not in the cache and could not be added to the cache.
+*/
+static uint8_t u8g2_glyph_cache_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding, u8g2_uint_t *dx)
+{
+  u8g2_glyph_cache_entry_t *e;
+  const uint8_t *glyph_data;
+  uint8_t dir = u8g2_glyph_cache_dir(u8g2);
+  uint8_t is_vertical = (u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb) ? 0 : 1;
+  
+  e = u8g2_glyph_cache_find(u8g2, encoding, dir, is_vertical);
+  if ( e != NULL )
+  {
+    u8g2_glyph_cache_touch(u8g2, e);
+  }
+  else
+  {
+    glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
+    if ( glyph_data == NULL )
+    {
+      *dx = 0;
+      return 1;
+    }
+    e = u8g2_glyph_cache_add(u8g2, glyph_data, encoding, dir, is_vertical);
+    if ( e == NULL )
+      return 0;
+  }
+  u8g2_glyph_cache_draw(u8g2, e, x, y);
+  *dx = e->delta;
+  return 1;
+}
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
 {
   u8g2_uint_t dx = 0;
+#ifdef U8G2_WITH_GLYPH_CACHE
+  if ( u8g2->glyph_cache_ptr != NULL )
+    if ( u8g2_glyph_cache_draw_glyph(u8g2, x, y, encoding, &dx) != 0 )
+      return dx;
+#endif /* U8G2_WITH_GLYPH_CACHE */
   u8g2->font_decode.target_x = x;
   u8g2->font_decode.target_y = y;
   //u8g2->font_decode.is_transparent = is_transparent; this is already set
@@ -1286,6 +2074,9 @@ void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font)
 //#endif 
     u8g2->font = font;
     u8g2_read_font_info(&(u8g2->font_info), font);
+#ifdef U8G2_WITH_FONT_INDEX
+    u8g2_build_font_index(u8g2);
+#endif /* U8G2_WITH_FONT_INDEX */
     u8g2_UpdateRefHeight(u8g2);
     /* u8g2_SetFontPosBaseline(u8g2); */ /* removed with issue 195 */
   }
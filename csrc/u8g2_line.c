@@ -36,6 +36,133 @@
 #include "u8g2.h"
 
 
+/*
+  Lines with a larger delta will overflow the u8g2_int_t error term. 
+  The clipped line procedure calculates the state of the error term directly, 
+  which is only valid without overflow. Such lines are drawn pixel by pixel.
+*/
+#ifdef U8G2_16BIT
+#define U8G2_LINE_MAX_CLIP_DELTA 0x07fff
+#else
+#define U8G2_LINE_MAX_CLIP_DELTA 0x07f
+#endif
+
+/*
+  Draw the line with horizontal or vertical runs. Only the part of the line, 
+  which is inside the current page and clip window is calculated.
+  Same arguments as the loop in u8g2_DrawLine(): x1 <= x2, dy <= dx 
+  The result is identical to the pixel by pixel loop.
+*/
+static void u8g2_draw_clipped_line(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t dx, u8g2_uint_t dy, u8g2_int_t ystep, uint8_t swapxy)
+{
+  u8g2_uint_t major0, major1, minor0, minor1;	/* visible area */
+  u8g2_uint_t x, y, run_start;
+  u8g2_uint_t t;
+  u8g2_int_t err;
+  uint32_t k, kk, m;
+  uint8_t is_step;
+  
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  
+  if ( swapxy == 0 )
+  {
+    major0 = u8g2->user_x0;
+    major1 = u8g2->user_x1;
+    minor0 = u8g2->user_y0;
+    minor1 = u8g2->user_y1;
+  }
+  else
+  {
+    major0 = u8g2->user_y0;
+    major1 = u8g2->user_y1;
+    minor0 = u8g2->user_x0;
+    minor1 = u8g2->user_x1;
+  }
+  
+  /* clip against the major axis */
+  if ( x2 < major0 || x1 >= major1 )
+    return;
+  if ( x2 >= major1 )
+    x2 = major1-1;
+  k = 0;				/* number of steps, which are skipped */
+  if ( x1 < major0 )
+    k = major0 - x1;
+  
+  /* clip against the minor axis: find the first step with a visible y position */
+  t = 0;
+  if ( ystep > 0 )
+  {
+    if ( y1 >= minor1 )
+      return;
+    if ( y1 < minor0 )
+      t = minor0 - y1;
+  }
+  else
+  {
+    if ( y1 < minor0 )
+      return;
+    if ( y1 >= minor1 )
+      t = y1 - minor1 + 1;
+  }
+  if ( t > 0 )
+  {
+    if ( dy == 0 )
+      return;
+    /* y is changed t times after the first kk steps */
+    kk = ((uint32_t)(t-1)*dx + (dx>>1)) / dy + 1;
+    if ( kk > k )
+      k = kk;
+  }
+  if ( k > (uint32_t)(x2 - x1) )
+    return;
+  
+  /* calculate the state of the loop after k steps */
+  m = 0;
+  if ( k*dy > (uint32_t)(dx>>1) )
+    m = (k*dy - (dx>>1) + dx - 1) / dx;
+  err = (u8g2_int_t)((dx>>1) + m*dx - k*dy);
+  x = x1 + k;
+  y = y1;
+  if ( ystep > 0 )
+    y += m;
+  else
+    y -= m;
+  
+  for(;;)
+  {
+    /* find the end of the run */
+    run_start = x;
+    for(;;)
+    {
+      err -= (u8g2_uint_t)dy;
+      is_step = 0;
+      if ( err < 0 ) 
+      {
+	err += (u8g2_uint_t)dx;
+	is_step = 1;
+      }
+      if ( is_step != 0 || x == x2 )
+	break;
+      x++;
+    }
+    
+    if ( swapxy == 0 ) 
+      u8g2_DrawHVLine(u8g2, run_start, y, x-run_start+1, 0);
+    else 
+      u8g2_DrawHVLine(u8g2, y, run_start, x-run_start+1, 1);
+    
+    if ( x == x2 )
+      break;
+    x++;
+    y += (u8g2_uint_t)ystep;
+    if ( y < minor0 || y >= minor1 )
+      break;
+  }
+}
+
 void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2)
 {
   u8g2_uint_t tmp;
@@ -46,8 +173,6 @@ void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2,
 
   uint8_t swapxy = 0;
   
-  /* no intersection check at the moment, should be added... */
-
   if ( x1 > x2 ) dx = x1-x2; else dx = x2-x1;
   if ( y1 > y2 ) dy = y1-y2; else dy = y2-y1;
 
@@ -75,6 +200,12 @@ void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2,
     x2--;
 #endif
 
+  if ( dx <= U8G2_LINE_MAX_CLIP_DELTA )
+  {
+    u8g2_draw_clipped_line(u8g2, x1, y1, x2, dx, dy, ystep, swapxy);
+    return;
+  }
+  
   for( x = x1; x <= x2; x++ )
   {
     if ( swapxy == 0 ) 
@@ -89,4 +220,3 @@ void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2,
     }
   }
 }
-
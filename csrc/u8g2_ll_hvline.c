@@ -50,6 +50,7 @@
 
 #include "u8g2.h"
 #include <assert.h>
+#include <string.h>
 
 /*=================================================*/
 /*
@@ -71,7 +72,7 @@
 */
 void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
-  uint16_t offset;
+  size_t offset;
   uint8_t *ptr;
   uint8_t bit_pos, mask;
   uint8_t or_mask, xor_mask;
@@ -98,9 +99,9 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
     xor_mask = mask;
 
 
-  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset = y;		/* y might be 8 or 16 bit, but we need at least 16 bit, so use a size_t variable */
   offset &= ~7;
-  offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  offset *= u8g2_GetBufferTileWidth(u8g2);
   ptr = u8g2->tile_buf_ptr;
   ptr += offset;
   ptr += x;
@@ -120,34 +121,48 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
   }
   else
   {    
-    do
+    /* 
+      a vertical line covers up to 8 pixel of a byte: 
+      use a mask for the first and the last byte and set all bits of the bytes in between 
+    */
+    mask = 255;
+    mask <<= bit_pos;
+    if ( len < 8-bit_pos )
+    {
+      mask &= 255 >> (8-bit_pos-len);
+      len = 0;
+    }
+    else
+    {
+      len -= 8-bit_pos;
+    }
+    
+    for(;;)
     {
 #ifdef __unix
       assert(ptr < max_ptr);
 #endif
-      *ptr |= or_mask;
-      *ptr ^= xor_mask;
+      if ( u8g2->draw_color <= 1 )
+	*ptr |= mask;
+      if ( u8g2->draw_color != 1 )
+	*ptr ^= mask;
       
-      bit_pos++;
-      bit_pos &= 7;
-
-      len--;
-
-      if ( bit_pos == 0 )
+      if ( len == 0 )
+	break;
+      
+      ptr+=u8g2->pixel_buf_width;	/* 6 Jan 17: Changed u8g2->width to u8g2->pixel_buf_width, issue #148 */
+      
+      if ( len >= 8 )
       {
-	ptr+=u8g2->pixel_buf_width;	/* 6 Jan 17: Changed u8g2->width to u8g2->pixel_buf_width, issue #148 */
-		
-	if ( u8g2->draw_color <= 1 )
-	  or_mask  = 1;
-	if ( u8g2->draw_color != 1 )
-	  xor_mask = 1;
+	mask = 255;
+	len -= 8;
       }
       else
       {
-	or_mask <<= 1;
-	xor_mask <<= 1;
+	mask = 255 >> (8-len);
+	len = 0;
       }
-    } while( len != 0 );
+    }
   }
 }
 
@@ -160,7 +175,7 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 */
 static void u8g2_draw_pixel_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y)
 {
-  uint16_t offset;
+  size_t offset;
   uint8_t *ptr;
   uint8_t bit_pos, mask;
   
@@ -175,9 +190,9 @@ static void u8g2_draw_pixel_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_u
   mask = 1;
   mask <<= bit_pos;
 
-  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset = y;		/* y might be 8 or 16 bit, but we need at least 16 bit, so use a size_t variable */
   offset &= ~7;
-  offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  offset *= u8g2_GetBufferTileWidth(u8g2);
   ptr = u8g2->tile_buf_ptr;
   ptr += offset;
   ptr += x;
@@ -240,10 +255,50 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
     all clipping done
 */
 
+/*
+  fill cnt bytes with the draw color
+  for XOR mode, use machine words on 32 and 64 bit systems
+*/
+static void u8g2_ll_fill_horizontal_span(uint8_t *ptr, uint16_t cnt, uint8_t color)
+{
+  if ( color == 0 )
+  {
+    memset(ptr, 0, cnt);
+  }
+  else if ( color == 1 )
+  {
+    memset(ptr, 255, cnt);
+  }
+  else
+  {
+#if defined(UINTPTR_MAX) && UINTPTR_MAX > 0x0ffff
+    uintptr_t w;
+    while( cnt != 0 && ((uintptr_t)ptr & (sizeof(uintptr_t)-1)) != 0 )
+    {
+      *ptr++ ^= 255;
+      cnt--;
+    }
+    while( cnt >= sizeof(uintptr_t) )
+    {
+      memcpy(&w, ptr, sizeof(uintptr_t));	/* aligned, will be a single load */
+      w = ~w;
+      memcpy(ptr, &w, sizeof(uintptr_t));
+      ptr += sizeof(uintptr_t);
+      cnt -= sizeof(uintptr_t);
+    }
+#endif
+    while( cnt != 0 )
+    {
+      *ptr++ ^= 255;
+      cnt--;
+    }
+  }
+}
+
 /* SH1122, LD7032, ST7920, ST7986, LC7981, T6963, SED1330, RA8835, MAX7219, LS0 */ 
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
-  uint16_t offset;
+  size_t offset;
   uint8_t *ptr;
   uint8_t bit_pos;
   uint8_t mask;
@@ -254,7 +309,7 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
   mask = 128;
   mask >>= bit_pos;
 
-  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset = y;		/* y might be 8 or 16 bit, but we need at least 16 bit, so use a size_t variable */
   offset *= tile_width;
   offset += x>>3;
   ptr = u8g2->tile_buf_ptr;
@@ -262,25 +317,45 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
   
   if ( dir == 0 )
   {
-      
-    do
+    /* 
+      the horizontal line is a sequence of bytes in the buffer: 
+      use a mask for the first and the last byte and fill all bytes in between 
+    */
+    if ( bit_pos != 0 )
     {
-
+      mask = 255;
+      mask >>= bit_pos;
+      if ( len < 8-bit_pos )
+      {
+	mask &= ~(uint8_t)(255 >> (bit_pos+len));
+	len = 0;
+      }
+      else
+      {
+	len -= 8-bit_pos;
+      }
       if ( u8g2->draw_color <= 1 )
 	*ptr |= mask;
       if ( u8g2->draw_color != 1 )
 	*ptr ^= mask;
-      
-      mask >>= 1;
-      if ( mask == 0 )
-      {
-	mask = 128;
-        ptr++;
-      }
-      
-      //x++;
-      len--;
-    } while( len != 0 );
+      ptr++;
+    }
+    
+    if ( len >= 8 )
+    {
+      u8g2_ll_fill_horizontal_span(ptr, len>>3, u8g2->draw_color);
+      ptr += len>>3;
+      len &= 7;
+    }
+    
+    if ( len != 0 )
+    {
+      mask = ~(uint8_t)(255 >> len);
+      if ( u8g2->draw_color <= 1 )
+	*ptr |= mask;
+      if ( u8g2->draw_color != 1 )
+	*ptr ^= mask;
+    }
   }
   else
   {
@@ -307,7 +382,7 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
 /* SH1122, LD7032, ST7920, ST7986, LC7981, T6963, SED1330, RA8835, MAX7219, LS0 */ 
 static void u8g2_draw_pixel_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y)
 {
-  uint16_t offset;
+  size_t offset;
   uint8_t *ptr;
   uint8_t bit_pos, mask;
 
@@ -323,7 +398,7 @@ static void u8g2_draw_pixel_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8
   mask >>= bit_pos;
   x >>= 3;
 
-  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset = y;		/* y might be 8 or 16 bit, but we need at least 16 bit, so use a size_t variable */
   offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
   offset += x;
   ptr = u8g2->tile_buf_ptr;
@@ -369,3 +444,103 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
 }
 
 #endif /* U8G2_WITH_HVLINE_SPEED_OPTIMIZATION */
+
+/*=================================================*/
+/*
+  u8g2_ll_hvline_horizontal_gray4
+    SSD1322, SSD1327, SH1122 (u8g2_SetGray4Buffer)
+
+  Each byte contains two pixel, the left pixel is the upper nibble.
+  One pixel row of the buffer has tile_width*4 bytes.
+
+  draw_color = 0:	clear the pixel
+  draw_color = 1:	assign u8g2->gray_level
+  draw_color = 2:	invert the gray value
+*/
+
+#ifdef U8G2_WITH_GRAY4
+
+static void u8g2_ll_draw_nibble_gray4(uint8_t *ptr, uint8_t mask, uint8_t color, uint8_t value)
+{
+  if ( color == 2 )
+  {
+    *ptr ^= mask;
+  }
+  else
+  {
+    *ptr &= ~mask;
+    if ( color == 1 )
+      *ptr |= value & mask;
+  }
+}
+
+/*
+  x,y		Upper left position of the line within the local buffer (not the display!)
+  len		length of the line in pixel, len must not be 0
+  dir		0: horizontal line (left to right)
+		1: vertical line (top to bottom)
+  asumption: 
+    all clipping done
+*/
+void u8g2_ll_hvline_horizontal_gray4(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  size_t offset;
+  uint8_t *ptr;
+  uint8_t value;
+  uint8_t color = u8g2->draw_color;
+  uint16_t bytes_per_row = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  u8g2_uint_t cnt;
+
+  bytes_per_row *= 4;
+  value = u8g2->gray_level & 15;
+  value |= value << 4;
+
+  offset = y;
+  offset *= bytes_per_row;
+  offset += x>>1;
+  ptr = u8g2->tile_buf_ptr;
+  ptr += offset;
+  
+  if ( dir == 0 )
+  {
+    if ( x & 1 )
+    {
+      u8g2_ll_draw_nibble_gray4(ptr, 0x0f, color, value);
+      ptr++;
+      len--;
+    }
+    
+    /* two pixel per byte */
+    cnt = len >> 1;
+    if ( cnt != 0 )
+    {
+      if ( color <= 1 )
+      {
+	memset(ptr, color == 0 ? 0 : value, cnt);
+	ptr += cnt;
+      }
+      else
+      {
+	do
+	{
+	  *ptr++ ^= 255;
+	  cnt--;
+	} while( cnt != 0 );
+      }
+    }
+    
+    if ( len & 1 )
+      u8g2_ll_draw_nibble_gray4(ptr, 0xf0, color, value);
+  }
+  else
+  {
+    do
+    {
+      u8g2_ll_draw_nibble_gray4(ptr, (x & 1) ? 0x0f : 0xf0, color, value);
+      ptr += bytes_per_row;
+      len--;
+    } while( len != 0 );
+  }
+}
+
+#endif /* U8G2_WITH_GRAY4 */
@@ -13,69 +13,34 @@
 /*===========================================*/
 /* local definitions */
 
-typedef int16_t pg_word_t;
-
-
-struct pg_point_struct
-{
-  pg_word_t x;
-  pg_word_t y;
-};
-
-typedef struct _pg_struct pg_struct;	/* forward declaration */
-
-struct pg_edge_struct
-{
-  pg_word_t x_direction;	/* 1, if x2 is greater than x1, -1 otherwise */
-  pg_word_t height;
-  pg_word_t current_x_offset;
-  pg_word_t error_offset;
-  
-  /* --- line loop --- */
-  pg_word_t current_y;
-  pg_word_t max_y;
-  pg_word_t current_x;
-  pg_word_t error;
-
-  /* --- outer loop --- */
-  uint8_t (*next_idx_fn)(pg_struct *pg, uint8_t i);
-  uint8_t curr_idx;
-};
-
-/* maximum number of points in the polygon */
-/* can be redefined, but highest possible value is 254 */
-#define PG_MAX_POINTS 6
+/* the polygon structures are defined in u8g2.h */
+typedef u8g2_pg_word_t pg_word_t;
+typedef u8g2_pg_struct pg_struct;
+#define PG_MAX_POINTS U8G2_PG_MAX_POINTS
 
 /* index numbers for the pge structures below */
 #define PG_LEFT 0
 #define PG_RIGHT 1
 
 
-struct _pg_struct
-{
-  struct pg_point_struct list[PG_MAX_POINTS];
-  uint8_t cnt;
-  uint8_t is_min_y_not_flat;
-  pg_word_t total_scan_line_cnt;
-  struct pg_edge_struct pge[2];	/* left and right line draw structures */
-};
-
 
 /*===========================================*/
 /* procedures, which should not be inlined (save as much flash ROM as possible */
 
 #define PG_NOINLINE U8G2_NOINLINE
 
-static uint8_t pge_Next(struct pg_edge_struct *pge) PG_NOINLINE;
+static uint8_t pge_Next(struct u8g2_pg_edge_struct *pge) PG_NOINLINE;
+#ifndef U8G2_WITH_POLYGON_EDGE_TABLE
 static uint8_t pg_inc(pg_struct *pg, uint8_t i) PG_NOINLINE;
 static uint8_t pg_dec(pg_struct *pg, uint8_t i) PG_NOINLINE;
 static void pg_expand_min_y(pg_struct *pg, pg_word_t min_y, uint8_t pge_idx) PG_NOINLINE;
 static void pg_line_init(pg_struct * const pg, uint8_t pge_index) PG_NOINLINE;
+#endif
 
 /*===========================================*/
 /* line draw algorithm */
 
-static uint8_t pge_Next(struct pg_edge_struct *pge)
+static uint8_t pge_Next(struct u8g2_pg_edge_struct *pge)
 {
   if ( pge->current_y >= pge->max_y )
     return 0;
@@ -93,7 +58,7 @@ static uint8_t pge_Next(struct pg_edge_struct *pge)
 }
 
 /* assumes y2 > y1 */
-static void pge_Init(struct pg_edge_struct *pge, pg_word_t x1, pg_word_t y1, pg_word_t x2, pg_word_t y2)
+static void pge_Init(struct u8g2_pg_edge_struct *pge, pg_word_t x1, pg_word_t y1, pg_word_t x2, pg_word_t y2)
 {
   pg_word_t dx = x2 - x1;
   pg_word_t width;
@@ -120,6 +85,34 @@ static void pge_Init(struct pg_edge_struct *pge, pg_word_t x1, pg_word_t y1, pg_
   pge->error_offset = width % pge->height;
 }
 
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+/* 
+  advance an edge from pge_Init() to scan line y, same result as (y - current_y) calls of pge_Next()
+  after k steps, the number of carries of the error term is
+    ceil(k*error_offset/height) 	if x_direction is 1
+    floor(k*error_offset/height) 	if x_direction is -1
+*/
+static void pge_Skip(struct u8g2_pg_edge_struct *pge, pg_word_t y)
+{
+  int32_t k;
+  int32_t e;
+  int32_t n;
+  
+  k = (int32_t)y - pge->current_y;
+  if ( k <= 0 )
+    return;
+  e = k * pge->error_offset;
+  n = e / pge->height;
+  if ( pge->x_direction > 0 && n * pge->height != e )
+    n++;
+  pge->current_x = (pg_word_t)(pge->current_x + k * pge->current_x_offset + n * pge->x_direction);
+  pge->error = (pg_word_t)(pge->error + e - n * pge->height);
+  pge->current_y = y;
+}
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
+
+#ifndef U8G2_WITH_POLYGON_EDGE_TABLE
+
 /*===========================================*/
 /* convex polygon algorithm */
 
@@ -246,7 +239,7 @@ static void pg_hline(pg_struct *pg, u8g2_t *u8g2)
 
 static void pg_line_init(pg_struct * const pg, uint8_t pge_index)
 {
-  struct pg_edge_struct  *pge = pg->pge+pge_index;
+  struct u8g2_pg_edge_struct  *pge = pg->pge+pge_index;
   uint8_t idx;  
   pg_word_t x1;
   pg_word_t y1;
@@ -293,16 +286,172 @@ static void pg_exec(pg_struct *pg, u8g2_t *u8g2)
   } while( i > 0 );
 }
 
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
+
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+
+/*===========================================*/
+/* scan line algorithm with edge table and active edge list */
+
+/*
+  list, cnt:	points of the polygon
+  et:		memory for cnt edges (edge table)
+  ael:		memory for cnt edge indices (active edge list)
+  
+  Same pixel as the convex polygon algorithm: Each edge covers the scan lines 
+  y1 <= y < y2, horizontal edges are ignored. The spans between the sorted 
+  edges of one scan line are drawn from x1 to x2-1 (even-odd rule).
+  Only edges which cross the user window are put into the edge table and the
+  scan lines start at the top of the user window.
+*/
+static void pg_scan(u8g2_t *u8g2, const struct u8g2_pg_point_struct *list, uint16_t cnt, struct u8g2_pg_edge_struct *et, uint16_t *ael)
+{
+  struct u8g2_pg_edge_struct tmp;
+  const struct u8g2_pg_point_struct *p1;
+  const struct u8g2_pg_point_struct *p2;
+  pg_word_t user_x0, user_x1, user_y0, user_y1;
+  pg_word_t y, x1, x2;
+  uint16_t i, j, gap;
+  uint16_t et_cnt, et_pos, ael_cnt, a;
+
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if ( u8g2->is_page_clip_window_intersection == 0 )
+    return;
+#endif /* U8G2_WITH_CLIP_WINDOW_SUPPORT */
+  if ( cnt < 3 )
+    return;
+  
+  user_x0 = u8g2->user_x0;
+  user_x1 = u8g2->user_x1;
+  user_y0 = u8g2->user_y0;
+  user_y1 = u8g2->user_y1;
+  
+  /* build the edge table, all edges are drawn from top to bottom */
+  et_cnt = 0;
+  p1 = list + cnt - 1;
+  for( i = 0; i < cnt; i++ )
+  {
+    p2 = list + i;
+    if ( p1->y < p2->y )
+    {
+      if ( p2->y > user_y0 && p1->y < user_y1 )
+	pge_Init(et + et_cnt++, p1->x, p1->y, p2->x, p2->y);
+    }
+    else if ( p1->y > p2->y )
+    {
+      if ( p1->y > user_y0 && p2->y < user_y1 )
+	pge_Init(et + et_cnt++, p2->x, p2->y, p1->x, p1->y);
+    }
+    p1 = p2;
+  }
+  
+  /* sort the edge table by the first scan line of each edge (shell sort) */
+  for( gap = et_cnt/2; gap > 0; gap /= 2 )
+  {
+    for( i = gap; i < et_cnt; i++ )
+    {
+      tmp = et[i];
+      for( j = i; j >= gap && et[j-gap].current_y > tmp.current_y; j -= gap )
+	et[j] = et[j-gap];
+      et[j] = tmp;
+    }
+  }
+  
+  et_pos = 0;
+  ael_cnt = 0;
+  y = user_y0;
+  while( y < user_y1 )
+  {
+    if ( ael_cnt == 0 )
+    {
+      /* continue with the next edge of the edge table */
+      if ( et_pos >= et_cnt )
+	break;
+      if ( y < et[et_pos].current_y )
+      {
+	y = et[et_pos].current_y;
+	if ( y >= user_y1 )
+	  break;
+      }
+    }
+    
+    /* move the edges, which start at this scan line, to the active edge list */
+    while( et_pos < et_cnt && et[et_pos].current_y <= y )
+    {
+      pge_Skip(et + et_pos, y);	/* edges above the user window */
+      ael[ael_cnt++] = et_pos++;
+    }
+    
+    /* sort the active edge list by x (insertion sort, the order changes only if edges cross) */
+    for( i = 1; i < ael_cnt; i++ )
+    {
+      a = ael[i];
+      for( j = i; j > 0 && et[ael[j-1]].current_x > et[a].current_x; j-- )
+	ael[j] = ael[j-1];
+      ael[j] = a;
+    }
+    
+    /* draw the spans between pairs of edges */
+    for( i = 1; i < ael_cnt; i += 2 )
+    {
+      x1 = et[ael[i-1]].current_x;
+      x2 = et[ael[i]].current_x;
+      if ( x1 < user_x0 )
+	x1 = user_x0;
+      if ( x2 > user_x1 )
+	x2 = user_x1;
+      if ( x1 < x2 )
+	u8g2_DrawHVLine(u8g2, x1, y, x2 - x1, 0);
+    }
+    
+    /* advance the active edges to the next scan line and remove finished edges */
+    j = 0;
+    for( i = 0; i < ael_cnt; i++ )
+    {
+      a = ael[i];
+      pge_Next(et + a);
+      if ( et[a].current_y < et[a].max_y )
+	ael[j++] = a;
+    }
+    ael_cnt = j;
+    y++;
+  }
+}
+
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
+
 /*===========================================*/
 /* API procedures */
 
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+/* the polygon buffer contains buf_max_cnt edges, points and active edge list entries */
+#define pg_buf_edges(pg) ((struct u8g2_pg_edge_struct *)((pg)->buf))
+#define pg_buf_points(pg) ((struct u8g2_pg_point_struct *)((pg)->buf + (size_t)(pg)->buf_max_cnt*sizeof(struct u8g2_pg_edge_struct)))
+#define pg_buf_ael(pg) ((uint16_t *)((pg)->buf + (size_t)(pg)->buf_max_cnt*(sizeof(struct u8g2_pg_edge_struct)+sizeof(struct u8g2_pg_point_struct))))
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
+
 static void pg_ClearPolygonXY(pg_struct *pg)
 {
   pg->cnt = 0;
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+  pg->buf_cnt = 0;
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
 }
 
 static void pg_AddPolygonXY(pg_struct *pg, int16_t x, int16_t y)
 {
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+  if ( pg->buf != NULL )
+  {
+    if ( pg->buf_cnt < pg->buf_max_cnt )
+    {
+      pg_buf_points(pg)[pg->buf_cnt].x = x;
+      pg_buf_points(pg)[pg->buf_cnt].y = y;
+      pg->buf_cnt++;
+    }
+    return;
+  }
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
   if ( pg->cnt < PG_MAX_POINTS )
   {
     pg->list[pg->cnt].x = x;
@@ -313,31 +462,114 @@ static void pg_AddPolygonXY(pg_struct *pg, int16_t x, int16_t y)
 
 static void pg_DrawPolygon(pg_struct *pg, u8g2_t *u8g2)
 {
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+  struct u8g2_pg_edge_struct et[PG_MAX_POINTS];
+  uint16_t ael[PG_MAX_POINTS];
+  
+  if ( pg->buf != NULL )
+    pg_scan(u8g2, pg_buf_points(pg), pg->buf_cnt, pg_buf_edges(pg), pg_buf_ael(pg));
+  else
+    pg_scan(u8g2, pg->list, pg->cnt, et, ael);
+#else
   if ( pg_prepare(pg) == 0 )
     return;
   pg_exec(pg, u8g2);
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
+}
+
+#ifdef U8G2_WITH_INSTANCE_POLYGON
+
+/* 
+  u8g2_ClearPolygonXY() does not know the u8g2 structure. It increments this 
+  counter and the points of a u8g2 structure are removed with the next access.
+*/
+static uint32_t u8g2_pg_clear_cnt = 0;
+
+static pg_struct *u8g2_get_pg(u8g2_t *u8g2)
+{
+  pg_struct *pg = &(u8g2->pg);
+  if ( pg->clear_cnt != u8g2_pg_clear_cnt )
+  {
+    pg->clear_cnt = u8g2_pg_clear_cnt;
+    pg_ClearPolygonXY(pg);
+  }
+  return pg;
 }
 
+void u8g2_ClearPolygonXY(void)
+{
+  u8g2_pg_clear_cnt++;
+}
+
+#else
+
 pg_struct u8g2_pg;
+#define u8g2_get_pg(u8g2) (&u8g2_pg)
 
 void u8g2_ClearPolygonXY(void)
 {
   pg_ClearPolygonXY(&u8g2_pg);
 }
 
+#endif
+
+/* remove the points of u8g2_AddPolygonXY(), use this instead of u8g2_ClearPolygonXY() for several threads */
+void u8g2_ClearPolygon(U8X8_UNUSED u8g2_t *u8g2)
+{
+  pg_ClearPolygonXY(u8g2_get_pg(u8g2));
+}
+
 void u8g2_AddPolygonXY(U8X8_UNUSED u8g2_t *u8g2, int16_t x, int16_t y)
 {
-  pg_AddPolygonXY(&u8g2_pg, x, y);
+  pg_AddPolygonXY(u8g2_get_pg(u8g2), x, y);
 }
 
 void u8g2_DrawPolygon(u8g2_t *u8g2)
 {
-  pg_DrawPolygon(&u8g2_pg, u8g2);
+  pg_DrawPolygon(u8g2_get_pg(u8g2), u8g2);
+}
+
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+/*
+  Use the memory area for the points of u8g2_AddPolygonXY(), the edge table and
+  the active edge list. Up to size/U8G2_POLYGON_BUFFER_SIZE(1) points are stored, 
+  U8G2_POLYGON_BUFFER_SIZE(n) bytes are enough for n points.
+  buf == NULL: Go back to the PG_MAX_POINTS points in the polygon structure.
+  The points are removed in both cases.
+*/
+void u8g2_SetPolygonBuffer(U8X8_UNUSED u8g2_t *u8g2, void *buf, size_t size)
+{
+  pg_struct *pg = u8g2_get_pg(u8g2);
+  uint8_t *ptr = (uint8_t *)buf;
+  size_t misalignment;
+  size_t cnt;
+  
+  /* edges contain a pointer, so start at an aligned address */
+  misalignment = (size_t)((uintptr_t)ptr % sizeof(void *));
+  if ( ptr != NULL && misalignment != 0 )
+  {
+    misalignment = sizeof(void *) - misalignment;
+    if ( size < misalignment )
+      size = misalignment;
+    ptr += misalignment;
+    size -= misalignment;
+  }
+  
+  cnt = size / (sizeof(struct u8g2_pg_edge_struct)+sizeof(struct u8g2_pg_point_struct)+sizeof(uint16_t));
+  if ( cnt > 0xffff )
+    cnt = 0xffff;
+  if ( cnt == 0 )
+    ptr = NULL;
+  
+  pg->buf = ptr;
+  pg->buf_max_cnt = cnt;
+  pg_ClearPolygonXY(pg);
 }
+#endif /* U8G2_WITH_POLYGON_EDGE_TABLE */
 
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
 {
-  u8g2_ClearPolygonXY();
+  u8g2_ClearPolygon(u8g2);
   u8g2_AddPolygonXY(u8g2, x0, y0);
   u8g2_AddPolygonXY(u8g2, x1, y1);
   u8g2_AddPolygonXY(u8g2, x2, y2);
@@ -0,0 +1,516 @@
+/*
+
+  u8g2_scroll.c
+
+  Scrolling of the buffer content and of the display memory.
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+  u8g2_ScrollBuffer() moves a rectangle of the buffer content by dx, dy
+  pixel. The pixel, which are moved out of the rectangle, are lost, the
+  exposed part of the rectangle is cleared. Only the content of the
+  rectangle is modified.
+  Positions are pixel positions of the buffer: In full buffer mode this is
+  the unrotated display. Display rotation and clip window are ignored.
+  A text ticker moves its line by one pixel and draws the new column only:
+
+    u8g2_ScrollBuffer(&u8g2, 0, 48, 128, 16, -1, 0);
+    u8g2_SetClipWindow(&u8g2, 127, 48, 128, 64);
+    u8g2_DrawStr(&u8g2, x, 62, text);
+    u8g2_SetMaxClipWindow(&u8g2);
+    u8g2_UpdateDisplayArea(&u8g2, 0, 6, 16, 2);
+
+  Complete bytes are moved with memmove(). The bits inside the bytes
+  (y direction for u8g2_ll_hvline_vertical_top_lsb, x direction for
+  u8g2_ll_hvline_horizontal_right_lsb) are shifted eight at once.
+  Other buffers (4 bit per pixel, display list) are not supported.
+
+  u8g2_ScrollDisplay() scrolls the full buffer by complete tile rows and
+  moves the content of the display memory with the start line command of the
+  controller (U8X8_MSG_DISPLAY_SET_START_TILE_ROW). Only the new tile rows
+  have to be sent to the display:
+
+    if ( u8g2_ScrollDisplay(&u8g2, 1) )
+    {
+      draw_last_line(&u8g2);
+      u8g2_UpdateDisplayArea(&u8g2, 0, 7, 16, 1);
+    }
+    else
+    {
+      draw_last_line(&u8g2);
+      u8g2_SendBuffer(&u8g2);
+    }
+
+  With a shadow buffer (u8g2_SetShadowBuffer()), u8g2_SendBuffer() will
+  send the new tile rows only.
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+/* bits of byte b (pixel b*8 ... b*8+7), which are inside the pixel range [p0, p1) */
+static uint8_t u8g2_scroll_mask(uint16_t b, uint16_t p0, uint16_t p1, uint8_t is_msb_first)
+{
+  uint16_t lo = b*8;
+  uint16_t hi = lo+8;
+  if ( lo < p0 )
+    lo = p0;
+  if ( hi > p1 )
+    hi = p1;
+  if ( lo >= hi )
+    return 0;
+  lo -= b*8;
+  hi -= b*8;
+  if ( is_msb_first )
+    return (uint8_t)(0xff >> lo) & (uint8_t)(0xff << (8-hi));
+  return (uint8_t)(0xff << lo) & (uint8_t)(0xff >> (8-hi));
+}
+
+/* copy the bits in mask from cnt source bytes to cnt destination bytes, both may overlap */
+static void u8g2_scroll_copy_line(uint8_t *dp, const uint8_t *sp, uint16_t cnt, uint8_t mask)
+{
+  uint16_t i;
+  if ( cnt == 0 )
+    return;
+  if ( mask == 0xff )
+  {
+    memmove(dp, sp, cnt);
+  }
+  else if ( dp > sp )
+  {
+    i = cnt;
+    do
+    {
+      i--;
+      dp[i] = (dp[i] & ~mask) | (sp[i] & mask);
+    } while( i > 0 );
+  }
+  else
+  {
+    for( i = 0; i < cnt; i++ )
+      dp[i] = (dp[i] & ~mask) | (sp[i] & mask);
+  }
+}
+
+/* clear the bits in mask of cnt bytes */
+static void u8g2_scroll_clear_line(uint8_t *dp, uint16_t cnt, uint8_t mask)
+{
+  uint16_t i;
+  if ( mask == 0xff )
+  {
+    memset(dp, 0, cnt);
+  }
+  else
+  {
+    for( i = 0; i < cnt; i++ )
+      dp[i] &= ~mask;
+  }
+}
+
+/*
+  Copy cnt bytes, the first and the last byte are masked.
+  The bytes are processed in the order, which is required for overlapping data.
+*/
+static void u8g2_scroll_copy_span(uint8_t *dp, const uint8_t *sp, uint16_t cnt, uint8_t first_mask, uint8_t last_mask)
+{
+  if ( cnt == 1 )
+  {
+    first_mask &= last_mask;
+    dp[0] = (dp[0] & ~first_mask) | (sp[0] & first_mask);
+  }
+  else if ( dp > sp )
+  {
+    dp[cnt-1] = (dp[cnt-1] & ~last_mask) | (sp[cnt-1] & last_mask);
+    memmove(dp+1, sp+1, cnt-2);
+    dp[0] = (dp[0] & ~first_mask) | (sp[0] & first_mask);
+  }
+  else
+  {
+    dp[0] = (dp[0] & ~first_mask) | (sp[0] & first_mask);
+    memmove(dp+1, sp+1, cnt-2);
+    dp[cnt-1] = (dp[cnt-1] & ~last_mask) | (sp[cnt-1] & last_mask);
+  }
+}
+
+/* clear cnt bytes, the first and the last byte are masked */
+static void u8g2_scroll_clear_span(uint8_t *dp, uint16_t cnt, uint8_t first_mask, uint8_t last_mask)
+{
+  if ( cnt == 1 )
+  {
+    dp[0] &= ~(first_mask & last_mask);
+  }
+  else
+  {
+    dp[0] &= ~first_mask;
+    memset(dp+1, 0, cnt-2);
+    dp[cnt-1] &= ~last_mask;
+  }
+}
+
+/*
+  The part [d0, d1) of the range [p, p+len) receives the moved pixel, the
+  part [e0, e1) is exposed. d is already limited to -len...len.
+*/
+static void u8g2_scroll_get_ranges(uint16_t p, uint16_t len, int16_t d, uint16_t *d0, uint16_t *d1, uint16_t *e0, uint16_t *e1)
+{
+  if ( d > 0 )
+  {
+    *d0 = p + d;
+    *d1 = p + len;
+    *e0 = p;
+    *e1 = p + d;
+  }
+  else
+  {
+    *d0 = p;
+    *d1 = p + len + d;
+    *e0 = p + len + d;
+    *e1 = p + len;
+  }
+}
+
+/*===========================================*/
+/* u8g2_ll_hvline_vertical_top_lsb: one byte contains eight pixel of a column, lsb is the top pixel */
+
+static void u8g2_scroll_vertical_x(uint8_t *buf, uint16_t stride, uint16_t x, uint16_t y, uint16_t w, uint16_t h, int16_t dx)
+{
+  uint16_t r;
+  uint16_t n;
+  uint8_t mask;
+  uint8_t *p;
+
+  for( r = y >> 3; r <= (y + h - 1) >> 3; r++ )
+  {
+    mask = u8g2_scroll_mask(r, y, y+h, 0);
+    p = buf + r*stride + x;
+    if ( dx > 0 )
+    {
+      n = w - dx;
+      u8g2_scroll_copy_line(p+dx, p, n, mask);
+      u8g2_scroll_clear_line(p, dx, mask);
+    }
+    else
+    {
+      n = w + dx;
+      u8g2_scroll_copy_line(p, p-dx, n, mask);
+      u8g2_scroll_clear_line(p+n, -dx, mask);
+    }
+  }
+}
+
+static void u8g2_scroll_vertical_y(uint8_t *buf, uint16_t stride, uint16_t rows, uint16_t x, uint16_t y, uint16_t w, uint16_t h, int16_t dy)
+{
+  uint16_t d0, d1, e0, e1;
+  int16_t r, r_last, r_step;
+  int16_t off, q;
+  uint16_t i;
+  uint8_t shift, mask, s;
+  uint8_t *dp;
+  const uint8_t *lo;
+  const uint8_t *hi;
+
+  u8g2_scroll_get_ranges(y, h, dy, &d0, &d1, &e0, &e1);
+
+  if ( d0 < d1 )
+  {
+    /* moving down: start with the bottom row, the source is above */
+    r = (d1 - 1) >> 3;
+    r_last = d0 >> 3;
+    r_step = -1;
+    if ( dy < 0 )
+    {
+      r = d0 >> 3;
+      r_last = (d1 - 1) >> 3;
+      r_step = 1;
+    }
+    for(;;)
+    {
+      mask = u8g2_scroll_mask(r, d0, d1, 0);
+      dp = buf + (uint16_t)r*stride + x;
+
+      /* source row of the top pixel of the destination byte, off >= -7 */
+      off = r*8 - dy;
+      q = (off + 8) / 8 - 1;
+      shift = off - q*8;
+      if ( shift == 0 )
+      {
+	/* aligned tile rows */
+	u8g2_scroll_copy_line(dp, buf + (uint16_t)q*stride + x, w, mask);
+      }
+      else
+      {
+	lo = NULL;
+	hi = NULL;
+	if ( q >= 0 )
+	  lo = buf + (uint16_t)q*stride + x;
+	if ( (uint16_t)(q+1) < rows )
+	  hi = buf + (uint16_t)(q+1)*stride + x;
+	if ( lo != NULL && hi != NULL )
+	{
+	  for( i = 0; i < w; i++ )
+	  {
+	    s = (lo[i] >> shift) | (hi[i] << (8-shift));
+	    dp[i] = (dp[i] & ~mask) | (s & mask);
+	  }
+	}
+	else
+	{
+	  for( i = 0; i < w; i++ )
+	  {
+	    s = 0;
+	    if ( lo != NULL )
+	      s = lo[i] >> shift;
+	    if ( hi != NULL )
+	      s |= hi[i] << (8-shift);
+	    dp[i] = (dp[i] & ~mask) | (s & mask);
+	  }
+	}
+      }
+
+      if ( r == r_last )
+	break;
+      r += r_step;
+    }
+  }
+
+  for( r = e0 >> 3; r <= (int16_t)((e1 - 1) >> 3); r++ )
+    u8g2_scroll_clear_line(buf + (uint16_t)r*stride + x, w, u8g2_scroll_mask(r, e0, e1, 0));
+}
+
+/*===========================================*/
+/* u8g2_ll_hvline_horizontal_right_lsb: one byte contains eight pixel of a row, msb is the left pixel */
+
+static void u8g2_scroll_horizontal_x(uint8_t *buf, uint16_t stride, uint16_t x, uint16_t y, uint16_t w, uint16_t h, int16_t dx)
+{
+  uint16_t d0, d1, e0, e1;
+  uint16_t c_first, c_last, c;
+  uint16_t j;
+  int16_t off, q0, q;
+  uint8_t shift, mask, s;
+  uint8_t first_mask, last_mask;
+  uint8_t *p;
+
+  u8g2_scroll_get_ranges(x, w, dx, &d0, &d1, &e0, &e1);
+
+  /* source byte and bit position of the left pixel of the first destination byte, off >= -7 */
+  c_first = d0 >> 3;
+  c_last = (d1 - 1) >> 3;
+  off = c_first*8 - dx;
+  q0 = (off + 8) / 8 - 1;
+  shift = off - q0*8;
+  first_mask = u8g2_scroll_mask(c_first, d0, d1, 1);
+  last_mask = u8g2_scroll_mask(c_last, d0, d1, 1);
+
+  for( j = y; j < y+h; j++ )
+  {
+    p = buf + j*stride;
+    if ( d0 < d1 )
+    {
+      if ( shift == 0 )
+      {
+	/* aligned bytes */
+	u8g2_scroll_copy_span(p + c_first, p + q0, c_last - c_first + 1, first_mask, last_mask);
+      }
+      else
+      {
+	/* moving right: start with the right byte, the source is on the left side */
+	c = c_last;
+	if ( dx < 0 )
+	  c = c_first;
+	for(;;)
+	{
+	  mask = 0xff;
+	  if ( c == c_first )
+	    mask &= first_mask;
+	  if ( c == c_last )
+	    mask &= last_mask;
+	  q = q0 + (int16_t)(c - c_first);
+	  s = 0;
+	  if ( q >= 0 )
+	    s = p[q] << shift;
+	  if ( (uint16_t)(q+1) < stride )
+	    s |= p[q+1] >> (8-shift);
+	  p[c] = (p[c] & ~mask) | (s & mask);
+	  if ( dx > 0 )
+	  {
+	    if ( c == c_first )
+	      break;
+	    c--;
+	  }
+	  else
+	  {
+	    if ( c == c_last )
+	      break;
+	    c++;
+	  }
+	}
+      }
+    }
+    u8g2_scroll_clear_span(p + (e0 >> 3), ((e1 - 1) >> 3) - (e0 >> 3) + 1, 
+      u8g2_scroll_mask(e0 >> 3, e0, e1, 1), u8g2_scroll_mask((e1 - 1) >> 3, e0, e1, 1));
+  }
+}
+
+static void u8g2_scroll_horizontal_y(uint8_t *buf, uint16_t stride, uint16_t x, uint16_t y, uint16_t w, uint16_t h, int16_t dy)
+{
+  uint16_t d0, d1, e0, e1;
+  uint16_t c_first = x >> 3;
+  uint16_t cnt = ((x + w - 1) >> 3) - c_first + 1;
+  uint8_t first_mask = u8g2_scroll_mask(c_first, x, x+w, 1);
+  uint8_t last_mask = u8g2_scroll_mask((x + w - 1) >> 3, x, x+w, 1);
+  uint16_t j;
+
+  u8g2_scroll_get_ranges(y, h, dy, &d0, &d1, &e0, &e1);
+
+  /* moving down: start with the bottom row, the source is above */
+  for( j = 0; j < d1 - d0; j++ )
+  {
+    if ( dy > 0 )
+      u8g2_scroll_copy_span(buf + (d1-1-j)*stride + c_first, buf + (d1-1-j-dy)*stride + c_first, cnt, first_mask, last_mask);
+    else
+      u8g2_scroll_copy_span(buf + (d0+j)*stride + c_first, buf + (d0+j-dy)*stride + c_first, cnt, first_mask, last_mask);
+  }
+
+  for( j = e0; j < e1; j++ )
+    u8g2_scroll_clear_span(buf + j*stride + c_first, cnt, first_mask, last_mask);
+}
+
+/*===========================================*/
+
+/*
+  Move the content of the rectangle x, y, w, h by dx, dy pixel (dx > 0: right, 
+  dy > 0: down). The exposed part of the rectangle is cleared.
+*/
+void u8g2_ScrollBuffer(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, int16_t dx, int16_t dy)
+{
+  uint16_t buf_w = u8g2->pixel_buf_width;
+  uint16_t buf_h = u8g2->pixel_buf_height;
+  uint16_t x0 = x, y0 = y, width = w, height = h;
+
+  if ( x0 >= buf_w || y0 >= buf_h )
+    return;
+  if ( width > buf_w - x0 )
+    width = buf_w - x0;
+  if ( height > buf_h - y0 )
+    height = buf_h - y0;
+  if ( width == 0 || height == 0 )
+    return;
+
+  /* a larger distance will clear the rectangle */
+  if ( dx > (int16_t)width )
+    dx = width;
+  if ( dx < -(int16_t)width )
+    dx = -(int16_t)width;
+  if ( dy > (int16_t)height )
+    dy = height;
+  if ( dy < -(int16_t)height )
+    dy = -(int16_t)height;
+
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    if ( dx != 0 )
+      u8g2_scroll_vertical_x(u8g2->tile_buf_ptr, buf_w, x0, y0, width, height, dx);
+    if ( dy != 0 )
+      u8g2_scroll_vertical_y(u8g2->tile_buf_ptr, buf_w, u8g2->tile_buf_height, x0, y0, width, height, dy);
+  }
+  else if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+  {
+    if ( dx != 0 )
+      u8g2_scroll_horizontal_x(u8g2->tile_buf_ptr, buf_w/8, x0, y0, width, height, dx);
+    if ( dy != 0 )
+      u8g2_scroll_horizontal_y(u8g2->tile_buf_ptr, buf_w/8, x0, y0, width, height, dy);
+  }
+}
+
+#ifdef U8X8_WITH_SCROLL
+
+#ifdef U8G2_WITH_SHADOW_BUFFER
+static void u8g2_scroll_reverse(uint8_t *p, uint8_t *q)
+{
+  uint8_t t;
+  while( p < q )
+  {
+    q--;
+    t = *p;
+    *p = *q;
+    *q = t;
+    p++;
+  }
+}
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+
+/*
+  Move the content of the display tile_rows tile rows up (tile_rows > 0) or 
+  down (tile_rows < 0). The full buffer is scrolled in the same way and the
+  exposed tile rows of the buffer are cleared. In page mode and with flush
+  rotation the buffer is not changed.
+  Returns 1 if the controller has moved the content of the display memory. Only
+  the exposed tile rows must be sent to the display. 
+  Returns 0 if the display does not support U8X8_MSG_DISPLAY_SET_START_TILE_ROW.
+  The complete buffer must be sent to the display.
+*/
+uint8_t u8g2_ScrollDisplay(u8g2_t *u8g2, int8_t tile_rows)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  uint8_t h = u8x8->display_info->tile_height;
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  size_t row_size, n;
+  int8_t cnt;
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+
+  if ( u8g2->tile_buf_height == h 
+#ifdef U8G2_WITH_FLUSH_ROTATION
+    && u8g2->cb != &u8g2_cb_flush_rotation
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+    )
+    u8g2_ScrollBuffer(u8g2, 0, 0, u8g2->pixel_buf_width, u8g2->pixel_buf_height, 0, -(int16_t)tile_rows*8);
+
+  if ( u8x8_ScrollTileRows(u8x8, tile_rows) == 0 )
+    return 0;
+
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  /* the shadow buffer must reflect the new content of the tile rows: rotate the tile rows of the shadow buffer */
+  if ( u8g2->shadow_buf_ptr != NULL && u8g2->is_shadow_buf_invalid == 0 )
+  {
+    cnt = tile_rows % (int8_t)h;
+    if ( cnt < 0 )
+      cnt += h;
+    row_size = (size_t)u8x8->display_info->tile_width*8;
+    n = row_size*(uint8_t)cnt;
+    u8g2_scroll_reverse(u8g2->shadow_buf_ptr, u8g2->shadow_buf_ptr + n);
+    u8g2_scroll_reverse(u8g2->shadow_buf_ptr + n, u8g2->shadow_buf_ptr + row_size*h);
+    u8g2_scroll_reverse(u8g2->shadow_buf_ptr, u8g2->shadow_buf_ptr + row_size*h);
+  }
+#endif /* U8G2_WITH_SHADOW_BUFFER */
+  return 1;
+}
+
+#endif /* U8X8_WITH_SCROLL */
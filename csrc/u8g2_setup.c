@@ -71,6 +71,14 @@ void u8g2_SetClipWindow(u8g2_t *u8g2, u8g2_uint_t clip_x0, u8g2_uint_t clip_y0,
 void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_draw_ll_hvline_cb ll_hvline_cb, const u8g2_cb_t *u8g2_cb)
 {
   u8g2->font = NULL;
+#ifdef U8G2_WITH_FONT_INDEX
+  u8g2->font_index_ptr = NULL;
+  u8g2->font_index_font = NULL;
+#endif
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2->glyph_cache_ptr = NULL;
+  u8g2->glyph_cache_used = 0;
+#endif
   //u8g2->kerning = NULL;
   //u8g2->get_kerning_cb = u8g2_GetNullKerning;
   
@@ -88,6 +96,32 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   u8g2->font_height_mode = 0; /* issue 2046 */
   u8g2->draw_color = 1;
   u8g2->is_auto_page_clear = 1;
+#ifdef U8G2_WITH_SHADOW_BUFFER
+  u8g2->shadow_buf_ptr = NULL;
+  u8g2->is_shadow_buf_invalid = 1;
+#endif
+#ifdef U8G2_WITH_PAGE_AREA
+  u8g2->is_page_area = 0;
+#endif
+#ifdef U8G2_WITH_INSTANCE_POLYGON
+  u8g2->pg.cnt = 0;
+  u8g2->pg.clear_cnt = 0;
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+  u8g2->pg.buf = NULL;
+  u8g2->pg.buf_max_cnt = 0;
+  u8g2->pg.buf_cnt = 0;
+#endif
+#endif
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2->dl_ptr = NULL;
+  u8g2->dl_pos = 0;
+  u8g2->dl_page_cnt = 0;
+  u8g2->dl_ll_hvline = NULL;
+#endif
+#ifdef U8G2_WITH_GRAY4
+  u8g2->is_gray4_buffer = 0;
+  u8g2->gray_level = 15;
+#endif
   
   u8g2->cb = u8g2_cb;
   u8g2->cb->update_dimension(u8g2);
@@ -115,6 +149,53 @@ void u8g2_SetDisplayRotation(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
   u8g2->cb->update_page_win(u8g2);
 }
 
+#ifdef U8G2_WITH_FLUSH_ROTATION
+/*
+  Rotate the buffer during u8g2_SendBuffer() instead of rotating each draw procedure.
+  u8g2_cb can be U8G2_R1 or U8G2_R3. All draw procedures will use the (fast) U8G2_R0
+  code on a buffer with swapped width and height. The tiles of this buffer are rotated 
+  by 90 degree when they are sent to the display.
+  Returns 0 if the rotation of the buffer is not possible. In this case the rotation is
+  assigned with u8g2_SetDisplayRotation(). Requirements:
+    - full buffer mode with u8g2_ll_hvline_vertical_top_lsb
+    - display width and height are a multiple of 8
+  u8g2_SetDisplayRotation() will leave this mode.
+  Limitations:
+    - u8g2_WriteBufferPBM() and u8g2_WriteBufferXBM() are not supported
+    - The display list (u8g2_BeginDisplayList()) is not supported
+*/
+uint8_t u8g2_SetFlushRotation(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  uint8_t is_ok = 1;
+  
+  if ( u8g2_cb != U8G2_R1 && u8g2_cb != U8G2_R3 )
+    is_ok = 0;
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    is_ok = 0;
+  if ( u8g2->tile_buf_height != display_info->tile_height )
+    is_ok = 0;
+  if ( display_info->pixel_width != display_info->tile_width*8 )
+    is_ok = 0;
+  if ( display_info->pixel_height != display_info->tile_height*8 )
+    is_ok = 0;
+#ifndef U8G2_16BIT
+  /* the height of the buffer must be less than 256 pixel */
+  if ( display_info->tile_width >= 32 || display_info->tile_height >= 32 )
+    is_ok = 0;
+#endif
+  
+  if ( is_ok == 0 )
+  {
+    u8g2_SetDisplayRotation(u8g2, u8g2_cb);
+    return 0;
+  }
+  u8g2->flush_rotation = u8g2_cb;
+  u8g2_SetDisplayRotation(u8g2, &u8g2_cb_flush_rotation);
+  return 1;
+}
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
 /*============================================*/
 
 void u8g2_SendF(u8g2_t * u8g2, const char *fmt, ...)
@@ -145,6 +226,9 @@ static void u8g2_update_dimension_common(u8g2_t *u8g2)
   t *= 8;
   u8g2->pixel_buf_height = t;
   
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  u8g2->tile_buf_width = display_info->tile_width;
+#endif
   t = display_info->tile_width;
 #ifndef U8G2_16BIT
   if ( t >= 32 )
@@ -301,6 +385,37 @@ void u8g2_update_page_win_r3(u8g2_t *u8g2)
 }
 
 
+#ifdef U8G2_WITH_FLUSH_ROTATION
+/*
+  Unrotated buffer for u8g2_SetFlushRotation(): The buffer has the size of the
+  display with swapped width and height. Each of the tile_width tile rows 
+  of the buffer has tile_height tiles. Only full buffer mode is supported.
+*/
+void u8g2_update_dimension_flush_rotation(u8g2_t *u8g2)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  u8g2_uint_t t;
+  
+  u8g2_update_dimension_common(u8g2);
+  
+  u8g2->tile_buf_width = display_info->tile_height;
+  t = display_info->tile_height;
+  t *= 8;
+  u8g2->pixel_buf_width = t;
+  
+  t = display_info->tile_width;
+  t *= 8;
+  u8g2->pixel_buf_height = t;
+  u8g2->pixel_curr_row = 0;
+  u8g2->buf_y0 = 0;
+  u8g2->buf_y1 = t;
+  
+  u8g2->width = display_info->pixel_height;
+  u8g2->height = display_info->pixel_width;
+}
+#endif /* U8G2_WITH_FLUSH_ROTATION */
+
+
 /*============================================*/
 extern void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
@@ -452,6 +567,10 @@ const u8g2_cb_t u8g2_cb_r3 = { u8g2_update_dimension_r3, u8g2_update_page_win_r3
   
 const u8g2_cb_t u8g2_cb_mirror = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_l90_mirrorr_r0 };
 const u8g2_cb_t u8g2_cb_mirror_vertical = { u8g2_update_dimension_r0, u8g2_update_page_win_r0, u8g2_draw_mirror_vertical_r0 };
+#ifdef U8G2_WITH_FLUSH_ROTATION
+/* U8G2_R0 draw procedures for u8g2_SetFlushRotation() */
+const u8g2_cb_t u8g2_cb_flush_rotation = { u8g2_update_dimension_flush_rotation, u8g2_update_page_win_r0, u8g2_draw_l90_r0 };
+#endif /* U8G2_WITH_FLUSH_ROTATION */
   
 /*============================================*/
 /* setup for the null device */
@@ -0,0 +1,506 @@
+/*
+
+  u8g2_surface.c
+
+  Offscreen surfaces and the copy of rectangles between u8g2 buffers.
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+  A surface is a u8g2 structure with a full buffer of any size, which is
+  not connected to a display. All draw procedures can be used for the
+  surface. Static parts of a picture are drawn once into a surface and
+  u8g2_BitBlt() copies them into the buffer of the display for each frame.
+
+  Usage:
+
+    static uint8_t bg_buf[U8G2_SURFACE_BUFFER_SIZE(128, 64)];
+    static u8g2_t bg;
+
+    u8g2_SetupSurface(&bg, bg_buf, 128, 64, u8g2_ll_hvline_vertical_top_lsb);
+    u8g2_ClearBuffer(&bg);
+    draw_background(&bg);
+
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      u8g2_BitBlt(&u8g2, 0, 0, &bg, 0, 0, 128, 64, U8G2_ROP_COPY);
+      draw_widgets(&u8g2);
+    } while( u8g2_NextPage(&u8g2) );
+
+  u8g2_BitBlt() uses the pixel positions of the buffer (the unrotated
+  display, except for u8g2_SetFlushRotation(), which rotates the buffer),
+  display rotation and clip window are ignored. The rectangle
+  is clipped against the source and the destination buffer. In page mode,
+  only the part of the current page is copied.
+
+  If source and destination have the same byte layout, eight pixel are
+  processed at once. A different byte layout is copied pixel by pixel.
+  Source and destination may be the same u8g2 structure, the rectangles
+  may overlap.
+
+*/
+
+#include "u8g2.h"
+
+#ifdef U8G2_WITH_SURFACE
+
+/*===========================================*/
+/* surface setup */
+
+/* a display without communication, the dimension is stored in the u8g2 structure */
+static uint8_t u8g2_d_surface_cb(u8x8_t *u8x8, uint8_t msg, U8X8_UNUSED uint8_t arg_int, U8X8_UNUSED void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_DISPLAY_SETUP_MEMORY:
+      u8x8_d_helper_display_setup_memory(u8x8, &(((u8g2_t *)u8x8)->surface_display_info));
+      break;
+    case U8X8_MSG_DISPLAY_INIT:
+      u8x8_d_helper_display_init(u8x8);
+      break;
+  }
+  return 1;
+}
+
+/*
+  buf:		U8G2_SURFACE_BUFFER_SIZE(width, height) bytes
+  ll_hvline_cb:	u8g2_ll_hvline_vertical_top_lsb or u8g2_ll_hvline_horizontal_right_lsb
+  width, height are rounded up to a multiple of 8 inside the buffer, max value is 2040,
+  larger values are reduced to 2040 (255 tiles)
+*/
+void u8g2_SetupSurface(u8g2_t *u8g2, uint8_t *buf, u8g2_uint_t width, u8g2_uint_t height, u8g2_draw_ll_hvline_cb ll_hvline_cb)
+{
+  u8x8_display_info_t *display_info = &(u8g2->surface_display_info);
+  uint16_t tile_width;
+  uint16_t tile_height;
+
+  /* pixel_width and pixel_height must not exceed the tile buffer, otherwise draw procedures write behind buf */
+  if ( (uint16_t)width > 255*8 )
+    width = 255*8;
+  if ( (uint16_t)height > 255*8 )
+    height = 255*8;
+  tile_width = ((uint16_t)width+7)/8;
+  tile_height = ((uint16_t)height+7)/8;
+
+  display_info->chip_enable_level = 0;
+  display_info->chip_disable_level = 1;
+  display_info->post_chip_enable_wait_ns = 0;
+  display_info->pre_chip_disable_wait_ns = 0;
+  display_info->reset_pulse_width_ms = 0;
+  display_info->post_reset_wait_ms = 0;
+  display_info->sda_setup_time_ns = 0;
+  display_info->sck_pulse_width_ns = 0;
+  display_info->sck_clock_hz = 4000000UL;
+  display_info->spi_mode = 0;
+  display_info->i2c_bus_clock_100kHz = 4;
+  display_info->data_setup_time_ns = 0;
+  display_info->write_pulse_width_ns = 0;
+  display_info->tile_width = tile_width;
+  display_info->tile_height = tile_height;
+  display_info->default_x_offset = 0;
+  display_info->flipmode_x_offset = 0;
+  display_info->pixel_width = width;
+  display_info->pixel_height = height;
+
+  u8g2_SetupDisplay(u8g2, u8g2_d_surface_cb, u8x8_cad_empty, u8x8_byte_empty, u8x8_dummy_cb);
+  u8g2_SetupBuffer(u8g2, buf, tile_height, ll_hvline_cb, U8G2_R0);
+}
+
+/*===========================================*/
+/* bit block transfer */
+
+/* byte layout of the buffer */
+#define U8G2_BLT_VERTICAL 0
+#define U8G2_BLT_HORIZONTAL 1
+#define U8G2_BLT_UNKNOWN 2
+
+static uint8_t u8g2_blt_get_layout(u8g2_t *u8g2)
+{
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+    return U8G2_BLT_VERTICAL;
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+    return U8G2_BLT_HORIZONTAL;
+  /* 4 bit per pixel buffer or display list recording */
+  return U8G2_BLT_UNKNOWN;
+}
+
+/* number of bytes from one row of the buffer to the next row (tile row for the vertical layout) */
+static uint16_t u8g2_blt_get_stride(u8g2_t *u8g2, uint8_t layout)
+{
+  if ( layout == U8G2_BLT_VERTICAL )
+    return (uint16_t)u8g2_GetBufferTileWidth(u8g2)*8;
+  return u8g2_GetBufferTileWidth(u8g2);
+}
+
+/* visible size of the buffer, width and height of the display are swapped by u8g2_SetFlushRotation() */
+static void u8g2_blt_get_size(u8g2_t *u8g2, uint16_t *width, uint16_t *height)
+{
+  const u8x8_display_info_t *display_info = u8g2_GetU8x8(u8g2)->display_info;
+  
+  *width = display_info->pixel_width;
+  *height = display_info->pixel_height;
+#ifdef U8G2_WITH_FLUSH_ROTATION
+  if ( u8g2->cb == &u8g2_cb_flush_rotation )
+  {
+    *width = display_info->pixel_height;
+    *height = display_info->pixel_width;
+  }
+#endif
+  if ( *width > u8g2->pixel_buf_width )
+    *width = u8g2->pixel_buf_width;
+}
+
+/*
+  Each raster operation is written as dst = (dst & a) ^ b, where a and b
+  depend on the source only: a = (src & a_and) ^ a_xor, b = (src & b_and) ^ b_xor
+*/
+struct u8g2_blt_rop_struct
+{
+  uint8_t a_and;
+  uint8_t a_xor;
+  uint8_t b_and;
+  uint8_t b_xor;
+};
+
+static const struct u8g2_blt_rop_struct u8g2_blt_rop_list[] =
+{
+  { 0x00, 0x00, 0xff, 0x00 },	/* U8G2_ROP_COPY: (dst & 0) ^ src */
+  { 0xff, 0xff, 0xff, 0x00 },	/* U8G2_ROP_OR: (dst & ~src) ^ src */
+  { 0xff, 0x00, 0x00, 0x00 },	/* U8G2_ROP_AND: (dst & src) ^ 0 */
+  { 0x00, 0xff, 0xff, 0x00 },	/* U8G2_ROP_XOR: (dst & 0xff) ^ src */
+  { 0x00, 0x00, 0xff, 0xff }	/* U8G2_ROP_NOT: (dst & 0) ^ ~src */
+};
+
+/* apply the raster operation to the bits of dst, which are set in mask */
+static uint8_t u8g2_blt_rop(const struct u8g2_blt_rop_struct *rop, uint8_t dst, uint8_t src, uint8_t mask)
+{
+  uint8_t a = (src & rop->a_and) ^ rop->a_xor;
+  uint8_t b = (src & rop->b_and) ^ rop->b_xor;
+  return (dst & (a | ~mask)) ^ (b & mask);
+}
+
+/*
+  vertical_top_lsb: one byte contains eight pixel of a column, lsb is the top pixel
+  x, y, w, h are already clipped, y is relative to the buffer
+  The eight source pixel for one destination byte are taken from two source tile rows.
+*/
+static void u8g2_blt_vertical(u8g2_t *dst, uint16_t dx, uint16_t dy, u8g2_t *src, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h, const struct u8g2_blt_rop_struct *rop, uint8_t is_reverse_x, uint8_t is_reverse_y)
+{
+  uint16_t dst_stride = u8g2_blt_get_stride(dst, U8G2_BLT_VERTICAL);
+  uint16_t src_stride = u8g2_blt_get_stride(src, U8G2_BLT_VERTICAL);
+  int16_t src_rows = src->pixel_buf_height/8;	/* tile rows of the buffer, not tile_buf_height for the flush rotation */
+  int16_t r, r_first, r_last, r_step;
+  int16_t q, off;
+  uint16_t i;
+  int16_t i_step;
+  uint8_t shift, mask;
+  uint8_t *dp;
+  const uint8_t *lo;
+  const uint8_t *hi;
+  uint8_t s;
+
+  r_first = dy >> 3;
+  r_last = (dy + h - 1) >> 3;
+  r_step = 1;
+  if ( is_reverse_y )
+  {
+    r = r_first;
+    r_first = r_last;
+    r_last = r;
+    r_step = -1;
+  }
+
+  r = r_first;
+  for(;;)
+  {
+    mask = 0xff;
+    if ( r == (dy >> 3) )
+      mask &= (uint8_t)(0xff << (dy & 7));
+    if ( r == ((dy + h - 1) >> 3) )
+      mask &= (uint8_t)(0xff >> (7 - ((dy + h - 1) & 7)));
+
+    /* source row of the top pixel of the destination byte, off >= -7 */
+    off = (int16_t)(r*8) - (int16_t)dy + (int16_t)sy;
+    q = (off + 8) / 8 - 1;
+    shift = off - q*8;
+    lo = NULL;
+    hi = NULL;
+    if ( q >= 0 )
+      lo = src->tile_buf_ptr + (uint16_t)q*src_stride + sx;
+    if ( shift != 0 && q+1 < src_rows )
+      hi = src->tile_buf_ptr + (uint16_t)(q+1)*src_stride + sx;
+    dp = dst->tile_buf_ptr + (uint16_t)r*dst_stride + dx;
+
+    i = 0;
+    i_step = 1;
+    if ( is_reverse_x )
+    {
+      i = w-1;
+      i_step = -1;
+    }
+
+    if ( lo != NULL && hi == NULL && shift == 0 )
+    {
+      /* aligned rows */
+      do
+      {
+	dp[i] = u8g2_blt_rop(rop, dp[i], lo[i], mask);
+	i += i_step;
+      } while( i < w );
+    }
+    else
+    {
+      do
+      {
+	s = 0;
+	if ( lo != NULL )
+	  s = lo[i] >> shift;
+	if ( hi != NULL )
+	  s |= hi[i] << (8-shift);
+	dp[i] = u8g2_blt_rop(rop, dp[i], s, mask);
+	i += i_step;
+      } while( i < w );
+    }
+
+    if ( r == r_last )
+      break;
+    r += r_step;
+  }
+}
+
+/*
+  horizontal_right_lsb: one byte contains eight pixel of a row, msb is the left pixel
+  x, y, w, h are already clipped, y is relative to the buffer
+  The eight source pixel for one destination byte are taken from two source bytes.
+*/
+static void u8g2_blt_horizontal(u8g2_t *dst, uint16_t dx, uint16_t dy, u8g2_t *src, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h, const struct u8g2_blt_rop_struct *rop, uint8_t is_reverse_x, uint8_t is_reverse_y)
+{
+  uint16_t dst_stride = u8g2_blt_get_stride(dst, U8G2_BLT_HORIZONTAL);
+  int16_t src_stride = u8g2_blt_get_stride(src, U8G2_BLT_HORIZONTAL);
+  uint16_t c_first = dx >> 3;
+  uint16_t c_last = (dx + w - 1) >> 3;
+  uint8_t first_mask = 0xff >> (dx & 7);
+  uint8_t last_mask = 0xff << (7 - ((dx + w - 1) & 7));
+  int16_t off, q0, q;
+  uint16_t c, j;
+  int16_t c_step;
+  uint8_t shift, mask;
+  uint8_t *dp;
+  const uint8_t *sp;
+  uint8_t s;
+
+  /* source byte and bit position of the left pixel of the first destination byte, off >= -7 */
+  off = (int16_t)(c_first*8) - (int16_t)dx + (int16_t)sx;
+  q0 = (off + 8) / 8 - 1;
+  shift = off - q0*8;
+
+  c_step = 1;
+  if ( is_reverse_x )
+    c_step = -1;
+
+  for( j = 0; j < h; j++ )
+  {
+    if ( is_reverse_y )
+    {
+      dp = dst->tile_buf_ptr + (uint16_t)(dy + h - 1 - j)*dst_stride;
+      sp = src->tile_buf_ptr + (uint16_t)(sy + h - 1 - j)*src_stride;
+    }
+    else
+    {
+      dp = dst->tile_buf_ptr + (uint16_t)(dy + j)*dst_stride;
+      sp = src->tile_buf_ptr + (uint16_t)(sy + j)*src_stride;
+    }
+
+    c = c_first;
+    if ( is_reverse_x )
+      c = c_last;
+    for(;;)
+    {
+      mask = 0xff;
+      if ( c == c_first )
+	mask &= first_mask;
+      if ( c == c_last )
+	mask &= last_mask;
+      q = q0 + (int16_t)(c - c_first);
+      if ( shift == 0 )
+      {
+	/* aligned bytes */
+	s = sp[q];
+      }
+      else
+      {
+	s = 0;
+	if ( q >= 0 )
+	  s = sp[q] << shift;
+	if ( q+1 < src_stride )
+	  s |= sp[q+1] >> (8-shift);
+      }
+      dp[c] = u8g2_blt_rop(rop, dp[c], s, mask);
+      if ( c == (is_reverse_x ? c_first : c_last) )
+	break;
+      c += c_step;
+    }
+  }
+}
+
+static uint8_t u8g2_blt_get_pixel(u8g2_t *u8g2, uint8_t layout, uint16_t stride, uint16_t x, uint16_t y)
+{
+  if ( layout == U8G2_BLT_VERTICAL )
+    return (u8g2->tile_buf_ptr[(y >> 3)*stride + x] >> (y & 7)) & 1;
+  return (u8g2->tile_buf_ptr[y*stride + (x >> 3)] >> (7 - (x & 7))) & 1;
+}
+
+static void u8g2_blt_set_pixel(u8g2_t *u8g2, uint8_t layout, uint16_t stride, uint16_t x, uint16_t y, const struct u8g2_blt_rop_struct *rop, uint8_t pixel)
+{
+  uint8_t *ptr;
+  uint8_t mask;
+
+  if ( layout == U8G2_BLT_VERTICAL )
+  {
+    ptr = u8g2->tile_buf_ptr + (y >> 3)*stride + x;
+    mask = 1 << (y & 7);
+  }
+  else
+  {
+    ptr = u8g2->tile_buf_ptr + y*stride + (x >> 3);
+    mask = 128 >> (x & 7);
+  }
+  *ptr = u8g2_blt_rop(rop, *ptr, pixel ? 0xff : 0, mask);
+}
+
+/* different byte layout of source and destination: copy pixel by pixel */
+static void u8g2_blt_pixel(u8g2_t *dst, uint8_t dst_layout, uint16_t dx, uint16_t dy, u8g2_t *src, uint8_t src_layout, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h, const struct u8g2_blt_rop_struct *rop)
+{
+  uint16_t dst_stride = u8g2_blt_get_stride(dst, dst_layout);
+  uint16_t src_stride = u8g2_blt_get_stride(src, src_layout);
+  uint16_t i, j;
+
+  for( j = 0; j < h; j++ )
+    for( i = 0; i < w; i++ )
+      u8g2_blt_set_pixel(dst, dst_layout, dst_stride, dx+i, dy+j, rop,
+	u8g2_blt_get_pixel(src, src_layout, src_stride, sx+i, sy+j));
+}
+
+/*
+  Copy the rectangle sx, sy, w, h of the source buffer to dx, dy of the destination buffer.
+  All positions are pixel positions of the buffer: the unrotated display,
+  or the rotated display after u8g2_SetFlushRotation().
+  rop: U8G2_ROP_COPY, U8G2_ROP_OR, U8G2_ROP_AND, U8G2_ROP_XOR, U8G2_ROP_NOT
+*/
+void u8g2_BitBlt(u8g2_t *dst, u8g2_uint_t dx, u8g2_uint_t dy, u8g2_t *src, u8g2_uint_t sx, u8g2_uint_t sy, u8g2_uint_t w, u8g2_uint_t h, uint8_t rop)
+{
+  uint8_t dst_layout = u8g2_blt_get_layout(dst);
+  uint8_t src_layout = u8g2_blt_get_layout(src);
+  uint16_t x0 = dx, y0 = dy, x1 = sx, y1 = sy;
+  uint16_t width = w, height = h;
+  uint16_t d;
+  uint16_t dst_width, dst_height;
+  uint16_t src_width, src_height;
+  uint16_t dst_y1 = dst->buf_y1;
+  uint16_t src_y1 = src->buf_y1;
+  uint8_t is_reverse_x = 0;
+  uint8_t is_reverse_y = 0;
+
+  if ( dst_layout == U8G2_BLT_UNKNOWN || src_layout == U8G2_BLT_UNKNOWN )
+    return;
+  if ( rop > U8G2_ROP_NOT )
+    return;
+
+  /* the last tile row of the buffer might be larger than the display */
+  u8g2_blt_get_size(dst, &dst_width, &dst_height);
+  u8g2_blt_get_size(src, &src_width, &src_height);
+  if ( dst_y1 > dst_height )
+    dst_y1 = dst_height;
+  if ( src_y1 > src_height )
+    src_y1 = src_height;
+
+  /* clip against the source buffer: x1/y1 must be inside [0, src_width) and [buf_y0, src_y1) */
+  if ( x1 >= src_width || y1 >= src_y1 )
+    return;
+  if ( width > src_width - x1 )
+    width = src_width - x1;
+  if ( height > src_y1 - y1 )
+    height = src_y1 - y1;
+  if ( y1 < src->buf_y0 )
+  {
+    d = src->buf_y0 - y1;
+    if ( d >= height )
+      return;
+    y1 += d;
+    y0 += d;
+    height -= d;
+  }
+
+  /* clip against the destination buffer */
+  if ( x0 >= dst_width || y0 >= dst_y1 )
+    return;
+  if ( width > dst_width - x0 )
+    width = dst_width - x0;
+  if ( height > dst_y1 - y0 )
+    height = dst_y1 - y0;
+  if ( y0 < dst->buf_y0 )
+  {
+    d = dst->buf_y0 - y0;
+    if ( d >= height )
+      return;
+    y0 += d;
+    y1 += d;
+    height -= d;
+  }
+  if ( width == 0 || height == 0 )
+    return;
+
+  /* rows relative to the buffers */
+  y0 -= dst->buf_y0;
+  y1 -= src->buf_y0;
+
+  if ( dst_layout != src_layout )
+  {
+    u8g2_blt_pixel(dst, dst_layout, x0, y0, src, src_layout, x1, y1, width, height, u8g2_blt_rop_list+rop);
+    return;
+  }
+
+  /* overlapping rectangles: read the source before it is overwritten */
+  if ( dst->tile_buf_ptr == src->tile_buf_ptr )
+  {
+    if ( x0 > x1 )
+      is_reverse_x = 1;
+    if ( y0 > y1 )
+      is_reverse_y = 1;
+  }
+
+  if ( dst_layout == U8G2_BLT_VERTICAL )
+    u8g2_blt_vertical(dst, x0, y0, src, x1, y1, width, height, u8g2_blt_rop_list+rop, is_reverse_x, is_reverse_y);
+  else
+    u8g2_blt_horizontal(dst, x0, y0, src, x1, y1, width, height, u8g2_blt_rop_list+rop, is_reverse_x, is_reverse_y);
+}
+
+#endif /* U8G2_WITH_SURFACE */
@@ -39,6 +39,7 @@
 #include "u8x8.h"
 
 
+
 /*
 static uint8_t u8log_is_on_screen(u8log_t *u8log, uint8_t x, uint8_t y)
 {
@@ -50,44 +51,69 @@ static uint8_t u8log_is_on_screen(u8log_t *u8log, uint8_t x, uint8_t y)
 }
 */
 
+/*
+  The screen_buffer is a ring of lines: Line y of the terminal is stored at
+  line (first_line + y) % height of the screen_buffer. Scrolling will just
+  move first_line.
+*/
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y)
+{
+  uint16_t line = u8log->first_line;
+  line += y;
+  if ( line >= u8log->height )
+    line -= u8log->height;
+  line *= u8log->width;
+  return u8log->screen_buffer + line;
+}
+
 static void u8log_clear_screen(u8log_t *u8log)
 {
-  uint8_t *dest = u8log->screen_buffer;
   uint16_t cnt = u8log->height;
   cnt *= u8log->width;
-  do
-  {
-    *dest++ = ' ';
-    cnt--;
-  } while( cnt > 0 );
-  
+  memset(u8log->screen_buffer, ' ', cnt);
+  u8log->first_line = 0;
 }
 
+/* add line y to the lines, which have to be redrawn */
+static void u8log_mark_line(u8log_t *u8log, uint8_t y)
+{
+  uint8_t last;
+  if ( y >= u8log->height )
+    return;
+  if ( u8log->redraw_line_cnt == 0 )
+  {
+    u8log->redraw_line = y;
+    u8log->redraw_line_cnt = 1;
+    return;
+  }
+  last = u8log->redraw_line + u8log->redraw_line_cnt - 1;
+  if ( y < u8log->redraw_line )
+    u8log->redraw_line = y;
+  if ( y > last )
+    last = y;
+  u8log->redraw_line_cnt = last - u8log->redraw_line + 1;
+}
 
-/* scroll the content of the complete buffer, set redraw_line to 255 */
+/* scroll the content of the screen by one line: the top line becomes the new (empty) bottom line */
 static void u8log_scroll_up(u8log_t *u8log)
 {
-  uint8_t *dest = u8log->screen_buffer;
-  uint8_t *src = dest+u8log->width;
-  uint16_t cnt = u8log->height;
-  cnt--;
-  cnt *= u8log->width;
-  do
-  {
-    *dest++ = *src++;
-    cnt--;
-  } while( cnt > 0 );
-  cnt = u8log->width;
-  do
-  {
-    *dest++ = ' ';
-    cnt--;
-  } while(cnt > 0);
+  memset(u8log_GetLine(u8log, 0), ' ', u8log->width);
+  u8log->first_line++;
+  if ( u8log->first_line >= u8log->height )
+    u8log->first_line = 0;
   
-  if ( u8log->is_redraw_line_for_each_char )
-    u8log->is_redraw_all = 1;
-  else
-    u8log->is_redraw_all_required_for_next_nl = 1;
+  if ( u8log->scroll_cnt < u8log->height )
+    u8log->scroll_cnt++;
+  
+  /* the changed lines have been moved up, the top line is gone */
+  if ( u8log->redraw_line_cnt != 0 )
+  {
+    if ( u8log->redraw_line > 0 )
+      u8log->redraw_line--;
+    else
+      u8log->redraw_line_cnt--;
+  }
+  u8log_mark_line(u8log, u8log->height-1);
 }
 
 /*
@@ -114,14 +140,12 @@ static void u8log_cursor_on_screen(u8log_t *u8log)
 static void u8log_write_to_screen(u8log_t *u8log, uint8_t c)
 {
   u8log_cursor_on_screen(u8log);
-  u8log->screen_buffer[u8log->cursor_y * u8log->width + u8log->cursor_x] = c;
+  u8log_GetLine(u8log, u8log->cursor_y)[u8log->cursor_x] = c;
   u8log->cursor_x++;
   
+  u8log_mark_line(u8log, u8log->cursor_y);
   if ( u8log->is_redraw_line_for_each_char )
-  {
-    u8log->is_redraw_line = 1;
-    u8log->redraw_line = u8log->cursor_y;
-  }
+    u8log->is_redraw_pending = 1;
 }
 
 /*
@@ -132,25 +156,23 @@ static void u8log_write_to_screen(u8log_t *u8log, uint8_t c)
     \r		13		Goto first position in the same line. Line is marked for redraw.
     \t		9		Jump to the next tab position
     \f		12		Clear the screen and mark redraw for whole screen
-    any other char	Write char to screen. Line redraw mark depends on 
-				is_redraw_line_for_each_char flag.
+    any other char	Write char to screen. The line is marked for redraw, but the redraw
+				is delayed until the next \n or \r, if the 
+				is_redraw_line_for_each_char flag is 0.
 */
-void u8log_write_char(u8log_t *u8log, uint8_t c)
+static void u8log_write_char(u8log_t *u8log, uint8_t c)
 {
   switch(c)
   {
     case '\n':	// 10
-      u8log->is_redraw_line = 1;
-      u8log->redraw_line = u8log->cursor_y;
-      if ( u8log->is_redraw_all_required_for_next_nl )
-	u8log->is_redraw_all = 1;
-      u8log->is_redraw_all_required_for_next_nl = 0;
+      u8log_mark_line(u8log, u8log->cursor_y);
+      u8log->is_redraw_pending = 1;
       u8log->cursor_y++;
       u8log->cursor_x = 0;
       break;	
     case '\r':	// 13
-      u8log->is_redraw_line = 1;
-      u8log->redraw_line = u8log->cursor_y;
+      u8log_mark_line(u8log, u8log->cursor_y);
+      u8log->is_redraw_pending = 1;
       u8log->cursor_x = 0;
       break;
     case '\t':	// 9
@@ -159,6 +181,7 @@ void u8log_write_char(u8log_t *u8log, uint8_t c)
     case '\f':	// 12
       u8log_clear_screen(u8log);
       u8log->is_redraw_all = 1;
+      u8log->is_redraw_pending = 1;
       u8log->cursor_x = 0;
       u8log->cursor_y = 0;
       break;
@@ -168,6 +191,23 @@ void u8log_write_char(u8log_t *u8log, uint8_t c)
   }
 }
 
+/*
+  Call the callback once for all changes of the last write procedure.
+*/
+static void u8log_redraw(u8log_t *u8log)
+{
+  if ( u8log->is_redraw_pending == 0 )
+    return;
+  if ( u8log->cb != 0 && ( u8log->is_redraw_all || u8log->redraw_line_cnt != 0 ) )
+  {
+    u8log->cb(u8log);
+  }
+  u8log->is_redraw_all = 0;
+  u8log->redraw_line_cnt = 0;
+  u8log->scroll_cnt = 0;
+  u8log->is_redraw_pending = 0;
+}
+
 void u8log_Init(u8log_t *u8log, uint8_t width, uint8_t height, uint8_t *buf)
 {
   memset(u8log, 0, sizeof(u8log_t));
@@ -199,52 +239,69 @@ void u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset)
 void u8log_WriteChar(u8log_t *u8log, uint8_t c)
 {
   u8log_write_char(u8log, c);
-  if ( u8log->is_redraw_line || u8log->is_redraw_all )
-  {
-    if ( u8log->cb != 0 )
-    {
-      u8log->cb(u8log);
-    }
-    u8log->is_redraw_line = 0;
-    u8log->is_redraw_all = 0;
-  }
+  u8log_redraw(u8log);
 }
 
+/* the callback is called only once for the complete string */
 void u8log_WriteString(u8log_t *u8log, const char *s)
 {
   while( *s != '\0' )
   {
-    u8log_WriteChar(u8log, *s);
+    u8log_write_char(u8log, *s);
     s++;
   }
+  u8log_redraw(u8log);
 }
 
-static void u8log_WriteHexHalfByte(u8log_t *u8log, uint8_t b) U8X8_NOINLINE;
-static void u8log_WriteHexHalfByte(u8log_t *u8log, uint8_t b)
+/* write cnt chars, the callback is called only once */
+void u8log_WriteBuffer(u8log_t *u8log, const uint8_t *buf, size_t cnt)
+{
+  while( cnt > 0 )
+  {
+    u8log_write_char(u8log, *buf);
+    buf++;
+    cnt--;
+  }
+  u8log_redraw(u8log);
+}
+
+static void u8log_write_hex_half_byte(u8log_t *u8log, uint8_t b) U8X8_NOINLINE;
+static void u8log_write_hex_half_byte(u8log_t *u8log, uint8_t b)
 {
   b &= 0x0f;
   if ( b < 10 )
-    u8log_WriteChar(u8log, b+'0');
+    u8log_write_char(u8log, b+'0');
   else
-    u8log_WriteChar(u8log, b+'a'-10);
+    u8log_write_char(u8log, b+'a'-10);
+}
+
+static void u8log_write_hex8(u8log_t *u8log, uint8_t b) U8X8_NOINLINE;
+static void u8log_write_hex8(u8log_t *u8log, uint8_t b)
+{
+  u8log_write_hex_half_byte(u8log, b >> 4);
+  u8log_write_hex_half_byte(u8log, b);
 }
 
 void u8log_WriteHex8(u8log_t *u8log, uint8_t b)
 {
-  u8log_WriteHexHalfByte(u8log, b >> 4);
-  u8log_WriteHexHalfByte(u8log, b);
+  u8log_write_hex8(u8log, b);
+  u8log_redraw(u8log);
 }
 
 void u8log_WriteHex16(u8log_t *u8log, uint16_t v)
 {
-  u8log_WriteHex8(u8log, v>>8);
-  u8log_WriteHex8(u8log, v);
+  u8log_write_hex8(u8log, v>>8);
+  u8log_write_hex8(u8log, v);
+  u8log_redraw(u8log);
 }
 
 void u8log_WriteHex32(u8log_t *u8log, uint32_t v)
 {
-  u8log_WriteHex16(u8log, v>>16);
-  u8log_WriteHex16(u8log, v);
+  u8log_write_hex8(u8log, v>>24);
+  u8log_write_hex8(u8log, v>>16);
+  u8log_write_hex8(u8log, v>>8);
+  u8log_write_hex8(u8log, v);
+  u8log_redraw(u8log);
 }
 
 /* v = value, d = number of digits (1..3) */
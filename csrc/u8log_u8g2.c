@@ -53,15 +53,17 @@ void u8g2_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log)
   u8g2_uint_t disp_x, disp_y;
   uint8_t buf_x, buf_y;
   uint8_t c;
+  uint8_t *line;
   
   disp_y = y;  
   u8g2_SetFontDirection(u8g2, 0);
   for( buf_y = 0; buf_y < u8log->height; buf_y++ )
   {
+    line = u8log_GetLine(u8log, buf_y);
     disp_x = x;
     for( buf_x = 0; buf_x < u8log->width; buf_x++ )
     {
-      c = u8log->screen_buffer[buf_y * u8log->width + buf_x];
+      c = line[buf_x];
       disp_x += u8g2_DrawGlyph(u8g2, disp_x, disp_y, c);
     }
     disp_y += u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2);
@@ -81,18 +83,75 @@ void u8g2_DrawLog(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8log_t *u8log)
     u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset)
   to change the line height.
   
+  Only the tile rows of the changed lines are drawn and sent (u8g2_FirstPageArea).
+  With U8G2_R0 and a line height, which is a multiple of 8, scrolling is done 
+  by the controller (u8g2_ScrollDisplay()), if this is supported by the display. 
+  Otherwise the complete log is drawn after scrolling.
+  
 */
 void u8log_u8g2_cb(u8log_t * u8log)
 {
   u8g2_t *u8g2 = (u8g2_t *)(u8log->aux_data);
-  if ( u8log->is_redraw_line || u8log->is_redraw_all )
+#ifdef U8G2_WITH_PAGE_AREA
+  int16_t line_height;
+  int16_t glyph_top, glyph_bottom;
+  int16_t y0, y1, t;
+  int16_t display_height = u8g2_GetDisplayHeight(u8g2);
+  
+  line_height = u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2);
+  line_height += u8log->line_height_offset;
+  /* the glyphs might exceed the line height: bounding box of the font, relative to the top of the line */
+  glyph_top = u8g2_GetAscent(u8g2) - u8g2_GetMaxCharHeight(u8g2) - u8g2->font_info.y_offset;
+  glyph_bottom = u8g2_GetAscent(u8g2) - u8g2->font_info.y_offset;
+  
+  y0 = 0;
+  y1 = display_height;
+  if ( u8log->is_redraw_all == 0 && line_height > 0 )
   {
-    u8g2_FirstPage(u8g2);
-    do
+    if ( u8log->scroll_cnt == 0 
+#ifdef U8X8_WITH_SCROLL
+      || ( u8log->scroll_cnt < u8log->height
+	&& u8g2->cb == U8G2_R0 
+	&& (line_height & 7) == 0
+	&& glyph_top >= 0
+	&& glyph_bottom <= line_height
+	&& u8g2_ScrollDisplay(u8g2, u8log->scroll_cnt*(line_height/8)) != 0 )
+#endif /* U8X8_WITH_SCROLL */
+      )
     {
-      u8g2_DrawLog( u8g2, 0, u8g2_GetAscent(u8g2), u8log);
+      y0 = u8log->redraw_line * line_height;
+      y1 = y0 + (u8log->redraw_line_cnt - 1) * line_height;
+      t = y1 + line_height;
+      y1 += glyph_bottom;
+      if ( y1 < t )
+	y1 = t;
+      if ( glyph_top < 0 )
+	y0 += glyph_top;
+      if ( u8log->scroll_cnt > 0 )
+      {
+	/* the bottom of the display shows the old top lines */
+	t = display_height - u8log->scroll_cnt * line_height;
+	if ( y0 > t )
+	  y0 = t;
+	y1 = display_height;
+      }
+      if ( y0 < 0 )
+	y0 = 0;
+      if ( y1 > display_height )
+	y1 = display_height;
     }
-    while( u8g2_NextPage(u8g2) );
   }
+  
+  /* u8g2_FirstPageArea() clears the tiles at the border of the area: start and end with a complete tile row */
+  y0 &= ~7;
+  y1 = (y1 + 7) & ~7;
+  u8g2_FirstPageArea(u8g2, 0, y0, u8g2_GetDisplayWidth(u8g2), y1 - y0);
+#else
+  u8g2_FirstPage(u8g2);
+#endif /* U8G2_WITH_PAGE_AREA */
+  do
+  {
+    u8g2_DrawLog( u8g2, 0, u8g2_GetAscent(u8g2), u8log);
+  }
+  while( u8g2_NextPage(u8g2) );
 }
-
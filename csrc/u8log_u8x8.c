@@ -40,11 +40,10 @@ static void u8x8_DrawLogLine(u8x8_t *u8x8, uint8_t disp_x, uint8_t disp_y, uint8
 static void u8x8_DrawLogLine(u8x8_t *u8x8, uint8_t disp_x, uint8_t disp_y, uint8_t buf_y, u8log_t *u8log)
 {
   uint8_t buf_x;
-  uint8_t c;
+  uint8_t *line = u8log_GetLine(u8log, buf_y);
   for( buf_x = 0; buf_x < u8log->width; buf_x++ )
   {
-    c = u8log->screen_buffer[buf_y * u8log->width + buf_x];
-    u8x8_DrawGlyph(u8x8, disp_x, disp_y, c);
+    u8x8_DrawGlyph(u8x8, disp_x, disp_y, line[buf_x]);
     disp_x++;
   }
 }
@@ -59,17 +58,42 @@ void u8x8_DrawLog(u8x8_t *u8x8, uint8_t x, uint8_t y, u8log_t *u8log)
   }
 }
 
-
+/*
+  u8lib callback for u8x8
+  
+  Only the changed lines are drawn. If the log has been scrolled and the
+  log covers all rows of the display, the content is moved by the controller 
+  (u8x8_ScrollTileRows()). Otherwise all lines are drawn after scrolling.
+*/
 void u8log_u8x8_cb(u8log_t * u8log)
 {
   u8x8_t *u8x8 = (u8x8_t *)(u8log->aux_data);
+  uint8_t y, cnt;
+  
+  y = u8log->redraw_line;
+  cnt = u8log->redraw_line_cnt;
   if ( u8log->is_redraw_all )
   {
-    u8x8_DrawLog(u8x8, 0, 0, u8log);
+    y = 0;
+    cnt = u8log->height;
   }
-  else if ( u8log->is_redraw_line )
+  else if ( u8log->scroll_cnt > 0 )
   {
-    u8x8_DrawLogLine(u8x8, 0, u8log->redraw_line, u8log->redraw_line, u8log);
+#ifdef U8X8_WITH_SCROLL
+    if ( u8log->scroll_cnt >= u8log->height 
+      || u8log->height != u8x8_GetRows(u8x8)
+      || u8x8_ScrollTileRows(u8x8, u8log->scroll_cnt) == 0 )
+#endif /* U8X8_WITH_SCROLL */
+    {
+      y = 0;
+      cnt = u8log->height;
+    }
+  }
+  
+  while( cnt > 0 )
+  {
+    u8x8_DrawLogLine(u8x8, 0, y, y, u8log);
+    y++;
+    cnt--;
   }
 }
-
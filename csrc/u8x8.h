@@ -96,6 +96,14 @@
 /* Define this for an additional user pointer inside the u8x8 data struct */
 //#define U8X8_WITH_USER_PTR
 
+/*
+  The transfer buffer collects the bytes of the cad procedures and sends them
+  with as few calls to the byte procedure as possible (u8x8_SetTransferBuffer).
+  Define this to enable the transfer buffer. It is enabled by default for
+  some platforms, see below. Use U8X8_WITHOUT_TRANSFER_BUFFER to disable it.
+*/
+//#define U8X8_WITH_TRANSFER_BUFFER
+
 
 /* Undefine this to remove u8x8_SetFlipMode function */
 /* 26 May 2016: Obsolete */
@@ -204,6 +212,55 @@ uint8_t u8x8_pgm_read_esp(const uint8_t * addr);   /* u8x8_8x8.c */
 #define U8X8_WITH_USER_PTR
 #endif
 
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8X8_WITHOUT_TRANSFER_BUFFER
+#define U8X8_WITH_TRANSFER_BUFFER
+#endif
+#endif
+
+/*
+  The following macro enables the U8X8_MSG_DISPLAY_DRAW_GRAY4 message for
+  grayscale controllers (SSD1322, SSD1327, SH1122), see u8x8_DrawGray4().
+  It is enabled for those uC which have enough RAM for a 4 bit per pixel buffer.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8X8_WITHOUT_GRAY4
+#define U8X8_WITH_GRAY4
+#endif
+#endif
+
+/*
+  The following macro enables the word based tile conversion for grayscale
+  displays (u8x8_convert.c). SSD1322 and SSD1327 will convert and send
+  U8X8_CONVERT_TILE_CNT tiles with one memory window. Each tile requires 32 bytes
+  on the stack, U8X8_CONVERT_TILE_CNT must not be larger than 7.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8X8_WITHOUT_FAST_CONVERT
+#define U8X8_WITH_FAST_CONVERT
+#endif
+#endif
+
+/*
+  The following macro enables the U8X8_MSG_DISPLAY_SET_START_TILE_ROW message,
+  see u8x8_ScrollTileRows(). Controllers with a start line command (SSD1306,
+  SH1106, ST7565) will move the visible content without a transfer of the
+  display memory.
+*/
+#if defined(unix) || defined(__unix__) || defined(__arm__) || defined(__arc__) || defined(ESP8266) || defined(ESP_PLATFORM) || defined(__LUATOS__)
+#ifndef U8X8_WITHOUT_SCROLL
+#define U8X8_WITH_SCROLL
+#endif
+#endif
+
+#ifndef U8X8_CONVERT_TILE_CNT
+#ifdef U8X8_WITH_FAST_CONVERT
+#define U8X8_CONVERT_TILE_CNT 7
+#else
+#define U8X8_CONVERT_TILE_CNT 1
+#endif
+#endif
+
 /*==========================================*/
 /* U8X8 typedefs and data structures */
 
@@ -356,6 +413,11 @@ struct u8x8_struct
 					/* i2c_address is the address for writing data to the display */
 					/* usually, the lowest bit must be zero for a valid address */
   uint8_t i2c_started;	/* for i2c interface */
+  uint8_t i2c_max_transfer;	/* max number of data bytes within one i2c transfer of the cad procedures, default is 24, must not be 0 */
+  uint8_t cad_in_transfer;	/* transfer state of the i2c cad procedures, 0: no transfer is active */
+  uint8_t cad_is_data;		/* uc16xx/uc1638 i2c cad: 1 if the current transfer sends data */
+  uint16_t cad_transfer_cnt;	/* ssd13xx bulk i2c cad: number of bytes within the current transfer */
+  uint8_t byte_state;		/* state of the byte procedure: last dc value (3wire sw spi), enable pin (sed1520) */
   //uint8_t device_address;	/* OBSOLETE???? - this is the device address, replacement for U8X8_MSG_CAD_SET_DEVICE */
   uint8_t utf8_state;		/* number of chars which are still to scan */
   uint8_t gpio_result;	/* return value from the gpio call (only for MENU keys at the moment) */ 
@@ -366,6 +428,16 @@ struct u8x8_struct
 #ifdef U8X8_WITH_USER_PTR
   void *user_ptr;
 #endif
+#ifdef U8X8_WITH_SCROLL
+  uint8_t start_tile_row;	/* tile row of the display memory, which is visible at the top of the display */
+#endif
+#ifdef U8X8_WITH_TRANSFER_BUFFER
+  u8x8_msg_cb transfer_byte_cb;	/* the byte procedure, which is called by u8x8_byte_transfer_buffer */
+  uint8_t *transfer_buf;
+  uint8_t transfer_buf_size;
+  uint8_t transfer_buf_len;	/* number of bytes in transfer_buf */
+  uint8_t transfer_dc;		/* last DC value, which was sent to transfer_byte_cb, 255: unknown */
+#endif
 #ifdef U8X8_USE_PINS 
   uint8_t pins[U8X8_PIN_CNT];	/* defines a pinlist: Mainly a list of pins for the Arduino Environment, use U8X8_PIN_xxx to access */
 #endif
@@ -381,6 +453,8 @@ struct u8x8_struct
 #define u8x8_GetRows(u8x8) ((u8x8)->display_info->tile_height)
 #define u8x8_GetI2CAddress(u8x8) ((u8x8)->i2c_address)
 #define u8x8_SetI2CAddress(u8x8, address) ((u8x8)->i2c_address = (address))
+#define u8x8_GetI2CMaxTransfer(u8x8) ((u8x8)->i2c_max_transfer)
+#define u8x8_SetI2CMaxTransfer(u8x8, cnt) ((u8x8)->i2c_max_transfer = (cnt))
 
 #define u8x8_SetGPIOResult(u8x8, val) ((u8x8)->gpio_result = (val))
 #define u8x8_GetSPIClockPhase(u8x8) ((u8x8)->display_info->spi_mode & 0x01)  /* 0 means rising edge */
@@ -407,7 +481,12 @@ struct u8x8_struct
 typedef struct u8log_struct u8log_t;
 
 
-/* redraw the specified line. */
+/* 
+  redraw the changed lines: 
+    is_redraw_all != 0: redraw all lines
+    otherwise: the content has been scrolled up by scroll_cnt lines, then 
+      redraw_line_cnt lines, starting with redraw_line, have been changed
+*/
 typedef void (*u8log_cb)(u8log_t * u8log);
 
 struct u8log_struct
@@ -416,17 +495,19 @@ struct u8log_struct
   void *aux_data;		/* pointer to u8x8 or u8g2 */
   uint8_t width, height;	/* size of the terminal */
   u8log_cb cb;			/* callback redraw function */
-  uint8_t *screen_buffer;	/* size must be width*height bytes */
+  uint8_t *screen_buffer;	/* size must be width*height bytes, use u8log_GetLine() to access a line */
   uint8_t is_redraw_line_for_each_char;
   int8_t line_height_offset;		/* extra offset for the line height (u8g2 only) */
   
   /* internal data */
   //uint8_t last_x, last_y;	/* position of the last printed char */
   uint8_t cursor_x, cursor_y;  /* position of the cursor, might be off screen */
-  uint8_t redraw_line;	/* redraw specific line if is_redraw_line is not 0 */
-  uint8_t is_redraw_line;
+  uint8_t first_line;		/* screen_buffer is a ring of lines, first_line is shown at the top */
+  uint8_t redraw_line;	/* first line, which has been changed, valid if redraw_line_cnt is not 0 */
+  uint8_t redraw_line_cnt;	/* number of changed lines, starting with redraw_line */
+  uint8_t scroll_cnt;		/* number of lines, which have been scrolled up since the last redraw */
   uint8_t is_redraw_all;
-  uint8_t is_redraw_all_required_for_next_nl; /* in nl mode, redraw all instead of current line */
+  uint8_t is_redraw_pending;	/* call the callback at the end of the current write procedure */
 };
 
 
@@ -533,6 +614,55 @@ void u8x8_d_helper_display_init(u8x8_t *u8g2);
 */
 #define U8X8_MSG_DISPLAY_REFRESH 16
 
+/*
+  Name: 	U8X8_MSG_DISPLAY_DRAW_GRAY4
+  Args:	
+    arg_int: number of tile rows
+    arg_ptr: pointer to u8x8_tile_t
+        uint8_t *tile_ptr;	pointer to the 4 bit per pixel data
+	uint8_t cnt;		number of tiles in each tile row
+	uint8_t x_pos;		first tile x position
+	uint8_t y_pos;		first tile y position 
+  Tasks:
+    Write a block of cnt*8 x arg_int*8 gray pixel to the display memory.
+    The data is a sequence of arg_int*8 pixel rows with cnt*4 bytes each.
+    Each byte contains two pixel, the left pixel is the upper nibble.
+    The display should write the block with one memory window, without
+    any conversion of the data.
+    This message is only supported by some grayscale displays. All other
+    displays return 0.
+  Use
+    uint8_t u8x8_DrawGray4(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *ptr)
+  to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_DRAW_GRAY4 17
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_SET_START_TILE_ROW
+  Args:	
+    arg_int: tile row of the display memory, which should appear at the top of the display
+    arg_ptr: -
+  Tasks:
+    Set the start line of the controller to arg_int*8. The display memory
+    is treated as a ring: The tile row tile_height-1 is followed by
+    tile row 0. U8X8_MSG_DISPLAY_DRAW_TILE must use u8x8->start_tile_row
+    to map the visible tile row y_pos to the tile row of the display memory.
+    This message is only supported by some displays. All other
+    displays return 0.
+  Use
+    uint8_t u8x8_ScrollTileRows(u8x8_t *u8x8, int8_t cnt)
+  to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_SET_START_TILE_ROW 18
+
+/*==========================================*/
+/* u8x8_convert.c */
+
+/* convert cnt tiles into 8 pixel rows with 4 bit per pixel, the result has cnt*32 bytes */
+uint8_t *u8x8_convert_tiles_to_4bpp(uint8_t *dest, const uint8_t *src, uint8_t cnt, uint8_t is_left_lower);
+/* rotate one tile (8 bytes) by 90 degree */
+void u8x8_convert_rotate_tile(uint8_t *dest, const uint8_t *src, uint8_t is_clockwise);
+
 /*==========================================*/
 /* u8x8_setup.c */
 
@@ -552,6 +682,17 @@ void u8x8_Setup(u8x8_t *u8x8, u8x8_msg_cb display_cb, u8x8_msg_cb cad_cb, u8x8_m
 /* u8x8_display.c */
 uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr);
 
+#ifdef U8X8_WITH_GRAY4
+/* returns 0 if the display does not support U8X8_MSG_DISPLAY_DRAW_GRAY4 */
+uint8_t u8x8_DrawGray4(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *ptr);
+#endif /* U8X8_WITH_GRAY4 */
+
+#ifdef U8X8_WITH_SCROLL
+/* move the content of the display cnt tile rows up (cnt > 0) or down (cnt < 0) */
+/* returns 0 if the display does not support U8X8_MSG_DISPLAY_SET_START_TILE_ROW */
+uint8_t u8x8_ScrollTileRows(u8x8_t *u8x8, int8_t cnt);
+#endif /* U8X8_WITH_SCROLL */
+
 /* 
   After a call to u8x8_SetupDefaults, 
   setup u8x8 memory structures & inform callbacks 
@@ -664,6 +805,7 @@ uint8_t u8x8_cad_100(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_st7920_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t u8x8_cad_ssd13xx_bulk_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_st75256_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);  /* CAD=001 */
@@ -703,6 +845,12 @@ uint8_t u8x8_byte_ssd13xx_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, voi
 uint8_t u8x8_byte_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 
+#ifdef U8X8_WITH_TRANSFER_BUFFER
+void u8x8_SetTransferBuffer(u8x8_t *u8x8, uint8_t *buf, uint8_t size);
+void u8x8_byte_FlushTransferBuffer(u8x8_t *u8x8);
+uint8_t u8x8_byte_transfer_buffer(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+#endif
+
 
 /*==========================================*/
 /* GPIO Interface */
@@ -1120,7 +1268,10 @@ void u8log_Init(u8log_t *u8log, uint8_t width, uint8_t height, uint8_t *buf);
 void u8log_SetCallback(u8log_t *u8log, u8log_cb cb, void *aux_data);
 void u8log_SetRedrawMode(u8log_t *u8log, uint8_t is_redraw_line_for_each_char);
 void u8log_SetLineHeightOffset(u8log_t *u8log, int8_t line_height_offset);
+/* the content of line y (0: top line) of the terminal, the line has width chars */
+uint8_t *u8log_GetLine(u8log_t *u8log, uint8_t y);
 void u8log_WriteString(u8log_t *u8log, const char *s) U8X8_NOINLINE;
+void u8log_WriteBuffer(u8log_t *u8log, const uint8_t *buf, size_t cnt);
 void u8log_WriteChar(u8log_t *u8log, uint8_t c) U8X8_NOINLINE;
 void u8log_WriteHex8(u8log_t *u8log, uint8_t b) U8X8_NOINLINE;
 void u8log_WriteHex16(u8log_t *u8log, uint16_t v);
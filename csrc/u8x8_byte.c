@@ -35,6 +35,7 @@
 */
 
 #include "u8x8.h"
+#include <string.h>
 
 uint8_t u8x8_byte_SetDC(u8x8_t *u8x8, uint8_t dc)
 {
@@ -77,6 +78,100 @@ uint8_t u8x8_byte_empty(U8X8_UNUSED u8x8_t *u8x8, uint8_t msg, U8X8_UNUSED uint8
   return 1;	/* always succeed */
 }
 
+/*=========================================*/
+
+#ifdef U8X8_WITH_TRANSFER_BUFFER
+
+/*
+  Transfer buffer
+
+  The cad procedures call the byte procedure for each command and arg byte.
+  The transfer buffer is placed between the cad and the byte procedure: It
+  collects all bytes with the same DC value and sends them with one
+  U8X8_MSG_BYTE_SEND. The buffer is sent, if
+    - DC changes (U8X8_MSG_BYTE_SET_DC with a different value),
+    - the transfer starts or ends,
+    - the buffer is full,
+    - a GPIO or delay message is sent (see u8x8_gpio_call), so that the timing
+      of the display init sequences is not changed.
+  Data blocks, which do not fit into the buffer, are sent without copy.
+  U8X8_MSG_BYTE_SET_DC is only sent, if the value changes.
+  The transfer buffer works with all cad and byte procedures.
+
+  Usage:
+    static uint8_t transfer_buf[64];
+    u8g2_Setup_ssd1322_nhd_256x64_f(&u8g2, U8G2_R0, ...);
+    u8x8_SetTransferBuffer(u8g2_GetU8x8(&u8g2), transfer_buf, sizeof(transfer_buf));
+    u8g2_InitDisplay(&u8g2);
+*/
+
+void u8x8_byte_FlushTransferBuffer(u8x8_t *u8x8)
+{
+  uint8_t len = u8x8->transfer_buf_len;
+  if ( len > 0 )
+  {
+    /* clear the buffer before the call, the byte procedure might call u8x8_gpio_call() */
+    u8x8->transfer_buf_len = 0;
+    u8x8->transfer_byte_cb(u8x8, U8X8_MSG_BYTE_SEND, len, u8x8->transfer_buf);
+  }
+}
+
+uint8_t u8x8_byte_transfer_buffer(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      if ( arg_int > u8x8->transfer_buf_size - u8x8->transfer_buf_len )
+      {
+	u8x8_byte_FlushTransferBuffer(u8x8);
+	if ( arg_int > u8x8->transfer_buf_size )
+	  return u8x8->transfer_byte_cb(u8x8, msg, arg_int, arg_ptr);
+      }
+      memcpy(u8x8->transfer_buf + u8x8->transfer_buf_len, arg_ptr, arg_int);
+      u8x8->transfer_buf_len += arg_int;
+      return 1;
+    case U8X8_MSG_BYTE_SET_DC:
+      if ( u8x8->transfer_dc == arg_int )
+	return 1;
+      u8x8_byte_FlushTransferBuffer(u8x8);
+      u8x8->transfer_dc = arg_int;
+      break;
+    case U8X8_MSG_BYTE_INIT:
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_byte_FlushTransferBuffer(u8x8);
+      u8x8->transfer_dc = 255;	/* the byte procedure might change DC */
+      break;
+    default:
+      u8x8_byte_FlushTransferBuffer(u8x8);
+      break;
+  }
+  return u8x8->transfer_byte_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+/*
+  Activate the transfer buffer. This must be called after the setup of u8x8
+  and before u8x8_InitDisplay(). A NULL pointer for buf will deactivate the 
+  transfer buffer.
+*/
+void u8x8_SetTransferBuffer(u8x8_t *u8x8, uint8_t *buf, uint8_t size)
+{
+  if ( u8x8->byte_cb == u8x8_byte_transfer_buffer )
+  {
+    u8x8_byte_FlushTransferBuffer(u8x8);
+    u8x8->byte_cb = u8x8->transfer_byte_cb;
+  }
+  if ( buf == NULL || size == 0 )
+    return;
+  u8x8->transfer_byte_cb = u8x8->byte_cb;
+  u8x8->transfer_buf = buf;
+  u8x8->transfer_buf_size = size;
+  u8x8->transfer_buf_len = 0;
+  u8x8->transfer_dc = 255;
+  u8x8->byte_cb = u8x8_byte_transfer_buffer;
+}
+
+#endif /* U8X8_WITH_TRANSFER_BUFFER */
+
 
 /*=========================================*/
 
@@ -272,7 +367,6 @@ uint8_t u8x8_byte_3wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
   uint8_t takeover_edge = u8x8_GetSPIClockPhase(u8x8);
   uint8_t not_takeover_edge = 1 - takeover_edge;
   uint16_t b;
-  static uint8_t last_dc;
  
   switch(msg)
   {
@@ -281,7 +375,7 @@ uint8_t u8x8_byte_3wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
       while( arg_int > 0 )
       {
 	b = *data;
-	if ( last_dc != 0 )
+	if ( u8x8->byte_state != 0 )
 	  b |= 256;
 	data++;
 	arg_int--;
@@ -310,7 +404,7 @@ uint8_t u8x8_byte_3wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
       u8x8_gpio_SetSPIClock(u8x8, u8x8_GetSPIClockPhase(u8x8));
       break;
     case U8X8_MSG_BYTE_SET_DC:
-      last_dc = arg_int;
+      u8x8->byte_state = arg_int;
       break;
     case U8X8_MSG_BYTE_START_TRANSFER:
       u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);  
@@ -398,7 +492,6 @@ uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_
 {
   uint8_t i, b;
   uint8_t *data;
-  static uint8_t enable_pin;
  
   switch(msg)
   {
@@ -416,10 +509,10 @@ uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_
 	}    
 	
 	u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->data_setup_time_ns);
-	u8x8_gpio_call(u8x8, enable_pin, 1);
+	u8x8_gpio_call(u8x8, u8x8->byte_state, 1);
 	u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_NANO, 200);		/* KS0108 requires 450 ns, use 200 here */
 	u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->write_pulse_width_ns);  /* expect 250 here */
-	u8x8_gpio_call(u8x8, enable_pin, 0);
+	u8x8_gpio_call(u8x8, u8x8->byte_state, 0);
       }
       break;
       
@@ -429,7 +522,7 @@ uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_
       /* ensure that the enable signals are low */
       u8x8_gpio_call(u8x8, U8X8_MSG_GPIO_E, 0);
       u8x8_gpio_call(u8x8, U8X8_MSG_GPIO_CS, 0);
-      enable_pin = U8X8_MSG_GPIO_E;
+      u8x8->byte_state = U8X8_MSG_GPIO_E;
       break;
     case U8X8_MSG_BYTE_SET_DC:
       u8x8_gpio_SetDC(u8x8, arg_int);
@@ -437,9 +530,9 @@ uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_
     case U8X8_MSG_BYTE_START_TRANSFER:
       /* cs lines are not supported for the SED1520/SBN1661 */
       /* instead, this will select the E1 or E2 line */ 
-      enable_pin = U8X8_MSG_GPIO_E;
+      u8x8->byte_state = U8X8_MSG_GPIO_E;
       if ( arg_int != 0 )
-	enable_pin = U8X8_MSG_GPIO_CS;
+	u8x8->byte_state = U8X8_MSG_GPIO_CS;
       break;
     case U8X8_MSG_BYTE_END_TRANSFER:
       break;
@@ -398,7 +398,7 @@ uint8_t u8x8_cad_st7920_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
   uint8_t *data;
   uint8_t b;
   uint8_t i;
-  static uint8_t buf[16];
+  uint8_t buf[16];
   uint8_t *ptr;
   
   switch(msg)
@@ -505,12 +505,14 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       /* Unfortunately, this can not be handled in the byte level drivers, */
       /* so this is done here. Even further, only 24 bytes will be sent, */
       /* because there will be another byte (DC) required during the transfer */
+      /* The limit is stored in i2c_max_transfer: Byte procedures with larger */
+      /* buffers may increase this value during U8X8_MSG_BYTE_INIT */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > u8x8->i2c_max_transfer )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, u8x8->i2c_max_transfer, p);
+	arg_int-=u8x8->i2c_max_transfer;
+	p+=u8x8->i2c_max_transfer;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       break;
@@ -533,7 +535,6 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 /* fast version with reduced data start/stops, issue 735 */
 uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;
   uint8_t *p;
   switch(msg)
   {
@@ -541,22 +542,22 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       /* improved version, takeover from ld7032 */
       /* assumes, that the args of a command is not longer than 31 bytes */
       /* speed improvement is about 4% compared to the classic version */
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	 u8x8_byte_EndTransfer(u8x8); 
       
       u8x8_byte_StartTransfer(u8x8);
       u8x8_byte_SendByte(u8x8, 0x000);	/* cmd byte for ssd13xx controller */
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
+      u8x8->cad_in_transfer = 1;
       /* lightning version: can replace the improved version from above */
       /* the drawback of the lightning version is this: The complete init sequence */
       /* must fit into the 32 byte Arduino Wire buffer, which might not always be the case */
       /* speed improvement is about 6% compared to the classic version */
-      // if ( in_transfer == 0 )
+      // if ( u8x8->cad_in_transfer == 0 )
 	// {
 	//   u8x8_byte_StartTransfer(u8x8);
 	//   u8x8_byte_SendByte(u8x8, 0x000);	/* cmd byte for ssd13xx controller */
-	//   in_transfer = 1;
+	//   u8x8->cad_in_transfer = 1;
 	// }
 	//u8x8_byte_SendByte(u8x8, arg_int);
       break;
@@ -564,7 +565,7 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       u8x8_byte_SendByte(u8x8, arg_int);
       break;      
     case U8X8_MSG_CAD_SEND_DATA:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
       
     
@@ -575,15 +576,17 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       /* Unfortunately, this can not be handled in the byte level drivers, */
       /* so this is done here. Even further, only 24 bytes will be sent, */
       /* because there will be another byte (DC) required during the transfer */
+      /* The limit is stored in i2c_max_transfer: Byte procedures with larger */
+      /* buffers may increase this value during U8X8_MSG_BYTE_INIT */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > u8x8->i2c_max_transfer )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, u8x8->i2c_max_transfer, p);
+	arg_int-=u8x8->i2c_max_transfer;
+	p+=u8x8->i2c_max_transfer;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     case U8X8_MSG_CAD_INIT:
       /* apply default i2c adr if required so that the start transfer msg can use this */
@@ -591,12 +594,12 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
 	u8x8->i2c_address = 0x078;
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     default:
       return 0;
@@ -606,6 +609,94 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
 
 
 
+/*
+  bulk version for byte procedures, which accept long transfers (e.g. Linux I2C_RDWR)
+  Each command and arg byte is prefixed with the control byte 0x80 (Co=1), so that
+  the commands and the following data are combined into one I2C transfer:
+    0x80 cmd 0x80 arg ... 0x40 data data data ...
+  After the control byte 0x40 (Co=0) only data is accepted by the controller, so a
+  command after data will start a new transfer. A transfer is also restarted if it
+  would exceed i2c_max_transfer+1 bytes (including control bytes).
+  With i2c_max_transfer = 255, one tile row of a 128 pixel display is sent in one transfer.
+  cad_in_transfer: 0: no transfer, 1: cmd/arg transfer, 2: data transfer
+  cad_transfer_cnt: number of bytes within the current transfer
+*/
+uint8_t u8x8_cad_ssd13xx_bulk_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint16_t limit = u8x8->i2c_max_transfer;
+  uint8_t *p;
+  uint8_t l;
+  
+  limit++;
+  switch(msg)
+  {
+    case U8X8_MSG_CAD_SEND_CMD:
+    case U8X8_MSG_CAD_SEND_ARG:
+      if ( u8x8->cad_in_transfer == 2 || ( u8x8->cad_in_transfer == 1 && u8x8->cad_transfer_cnt + 2 > limit ) )
+      {
+	u8x8_byte_EndTransfer(u8x8); 
+	u8x8->cad_in_transfer = 0;
+      }
+      if ( u8x8->cad_in_transfer == 0 )
+      {
+	u8x8_byte_StartTransfer(u8x8);
+	u8x8->cad_transfer_cnt = 0;
+	u8x8->cad_in_transfer = 1;
+      }
+      u8x8_byte_SendByte(u8x8, 0x080);	/* Co=1, D/C=0: one cmd byte, another control byte will follow */
+      u8x8_byte_SendByte(u8x8, arg_int);
+      u8x8->cad_transfer_cnt += 2;
+      break;
+    case U8X8_MSG_CAD_SEND_DATA:
+      p = arg_ptr;
+      while( arg_int > 0 )
+      {
+	if ( ( u8x8->cad_in_transfer == 1 && u8x8->cad_transfer_cnt + 2 > limit ) || ( u8x8->cad_in_transfer == 2 && u8x8->cad_transfer_cnt >= limit ) )
+	{
+	  u8x8_byte_EndTransfer(u8x8); 
+	  u8x8->cad_in_transfer = 0;
+	}
+	if ( u8x8->cad_in_transfer == 0 )
+	{
+	  u8x8_byte_StartTransfer(u8x8);
+	  u8x8->cad_transfer_cnt = 0;
+	  u8x8->cad_in_transfer = 1;
+	}
+	if ( u8x8->cad_in_transfer == 1 )
+	{
+	  u8x8_byte_SendByte(u8x8, 0x040);	/* Co=0, D/C=1: only data bytes will follow */
+	  u8x8->cad_transfer_cnt++;
+	  u8x8->cad_in_transfer = 2;
+	}
+	l = arg_int;
+	if ( l > limit - u8x8->cad_transfer_cnt )
+	  l = limit - u8x8->cad_transfer_cnt;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, l, p);
+	u8x8->cad_transfer_cnt += l;
+	arg_int -= l;
+	p += l;
+      }
+      break;
+    case U8X8_MSG_CAD_INIT:
+      /* apply default i2c adr if required so that the start transfer msg can use this */
+      if ( u8x8->i2c_address == 255 )
+	u8x8->i2c_address = 0x078;
+      return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
+    case U8X8_MSG_CAD_START_TRANSFER:
+      u8x8->cad_in_transfer = 0;
+      break;
+    case U8X8_MSG_CAD_END_TRANSFER:
+      if ( u8x8->cad_in_transfer != 0 )
+	u8x8_byte_EndTransfer(u8x8); 
+      u8x8->cad_in_transfer = 0;
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+
 /* the st75256 i2c driver is a copy of the ssd13xx driver, but with arg=1 */
 /* modified from cad001 (ssd13xx) to cad011 */
 uint8_t u8x8_cad_st75256_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -628,11 +719,11 @@ uint8_t u8x8_cad_st75256_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
     case U8X8_MSG_CAD_SEND_DATA:
       /* see ssd13xx driver */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > u8x8->i2c_max_transfer )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, u8x8->i2c_max_transfer, p);
+	arg_int-=u8x8->i2c_max_transfer;
+	p+=u8x8->i2c_max_transfer;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       break;
@@ -656,16 +747,15 @@ uint8_t u8x8_cad_st75256_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 /* Workaround is to remove the while loop (or increase the value in the condition) */
 uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;
   uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
       u8x8_byte_StartTransfer(u8x8);
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
+      u8x8->cad_in_transfer = 1;
       break;
     case U8X8_MSG_CAD_SEND_ARG:
       u8x8_byte_SendByte(u8x8, arg_int);
@@ -680,12 +770,14 @@ uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
       /* Unfortunately, this can not be handled in the byte level drivers, */
       /* so this is done here. Even further, only 24 bytes will be sent, */
       /* because there will be another byte (DC) required during the transfer */
+      /* The limit is stored in i2c_max_transfer: Byte procedures with larger */
+      /* buffers may increase this value during U8X8_MSG_BYTE_INIT */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > u8x8->i2c_max_transfer )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, u8x8->i2c_max_transfer, p);
+	arg_int-=u8x8->i2c_max_transfer;
+	p+=u8x8->i2c_max_transfer;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
 	u8x8_byte_SendByte(u8x8, 0x08);	/* data write for LD7032 */
@@ -698,10 +790,10 @@ uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8->i2c_address = 0x060;
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8); 
       break;
     default:
@@ -715,16 +807,14 @@ uint8_t u8x8_cad_ld7032_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 /* DC bit is encoded into the adr byte, structure is CAD001 */
 uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;	
-  static uint8_t is_data = 0;
   uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
     case U8X8_MSG_CAD_SEND_ARG:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data != 0 )
+	if ( u8x8->cad_is_data != 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -740,13 +830,13 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_byte_StartTransfer(u8x8);
       }
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
-      // is_data = 0;  // 20 Jun 2021: I assume that this is missing here
+      u8x8->cad_in_transfer = 1;
+      // u8x8->cad_is_data = 0;  // 20 Jun 2021: I assume that this is missing here
       break;
     case U8X8_MSG_CAD_SEND_DATA:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data == 0 )
+	if ( u8x8->cad_is_data == 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -761,15 +851,15 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_SetI2CAddress( u8x8, (u8x8_GetI2CAddress(u8x8)&0x0fc)|2 );
 	u8x8_byte_StartTransfer(u8x8);
       }
-      in_transfer = 1;
-      // is_data = 1;  // 20 Jun 2021: I assume that this is missing here
+      u8x8->cad_in_transfer = 1;
+      // u8x8->cad_is_data = 1;  // 20 Jun 2021: I assume that this is missing here
       
       p = arg_ptr;
-      while( arg_int > 24 )
+      while( arg_int > u8x8->i2c_max_transfer )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, u8x8->i2c_max_transfer, p);
+	arg_int-=u8x8->i2c_max_transfer;
+	p+=u8x8->i2c_max_transfer;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
       }
@@ -782,13 +872,13 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8->i2c_address = 0x070;
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;    
+      u8x8->cad_in_transfer = 0;    
       /* actual start is delayed, because we do not whether this is data or cmd transfer */
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8);
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     default:
       return 0;
@@ -801,15 +891,13 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 /* same as  u8x8_cad_uc16xx_i2c but CAD structure is CAD011 */
 uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;	
-  static uint8_t is_data = 0;
   uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data != 0 )
+	if ( u8x8->cad_is_data != 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -825,13 +913,13 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_byte_StartTransfer(u8x8);
       }
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
-      is_data = 0;
+      u8x8->cad_in_transfer = 1;
+      u8x8->cad_is_data = 0;
       break;
     case U8X8_MSG_CAD_SEND_ARG:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data == 0 )
+	if ( u8x8->cad_is_data == 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -847,13 +935,13 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_byte_StartTransfer(u8x8);
       }
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
-      is_data = 1;
+      u8x8->cad_in_transfer = 1;
+      u8x8->cad_is_data = 1;
       break;
     case U8X8_MSG_CAD_SEND_DATA:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
       {
-	if ( is_data == 0 )
+	if ( u8x8->cad_is_data == 0 )
 	{
 	  /* transfer mode is active, but data transfer */
 	  u8x8_byte_EndTransfer(u8x8); 
@@ -868,15 +956,15 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8_SetI2CAddress( u8x8, (u8x8_GetI2CAddress(u8x8)&0x0fc)|2 );
 	u8x8_byte_StartTransfer(u8x8);
       }
-      in_transfer = 1;
-      is_data = 1;
+      u8x8->cad_in_transfer = 1;
+      u8x8->cad_is_data = 1;
       
       p = arg_ptr;
-      while( arg_int > 24 )
+      while( arg_int > u8x8->i2c_max_transfer )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, u8x8->i2c_max_transfer, p);
+	arg_int-=u8x8->i2c_max_transfer;
+	p+=u8x8->i2c_max_transfer;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
       }
@@ -889,13 +977,13 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 	u8x8->i2c_address = 0x078;  /* see also https://github.com/olikraus/u8g2/issues/371 for a discussion on this value */
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
-      in_transfer = 0;    
+      u8x8->cad_in_transfer = 0;    
       /* actual start is delayed, because we do not whether this is data or cmd transfer */
       break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      if ( in_transfer != 0 )
+      if ( u8x8->cad_in_transfer != 0 )
 	u8x8_byte_EndTransfer(u8x8);
-      in_transfer = 0;
+      u8x8->cad_in_transfer = 0;
       break;
     default:
       return 0;
@@ -0,0 +1,202 @@
+/*
+  
+  u8x8_convert.c
+  
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2023, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+  
+  
+  Conversion of tiles (8x8 pixel, vertical_top) into the memory format of
+  grayscale controllers and rotation of tiles.
+  
+  The word based conversion (U8X8_WITH_FAST_CONVERT) transposes the 8x8 bits 
+  of a tile with a few 32 bit operations and then expands each pixel row with 
+  a lookup table. The bitwise conversion is used for all other uC.
+  
+*/
+
+
+#include "u8x8.h"
+
+#ifdef U8X8_WITH_FAST_CONVERT
+
+/* two 4 bit pixel for the lowest two bits of the pixel row (bit 0 is the left pixel) */
+static const uint8_t u8x8_convert_left_upper[4] = { 0x00, 0x0f0, 0x00f, 0x0ff };
+static const uint8_t u8x8_convert_left_lower[4] = { 0x00, 0x00f, 0x0f0, 0x0ff };
+
+/*
+  transpose 8x8 bits: bit r of src[c] is copied to bit c of dest[r]
+  x contains bytes 0..3 of the tile, y contains bytes 4..7
+*/
+static void u8x8_convert_transpose(uint8_t *dest, const uint8_t *src)
+{
+  uint32_t x, y, t;
+  
+  x = src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+  y = src[4] | ((uint32_t)src[5] << 8) | ((uint32_t)src[6] << 16) | ((uint32_t)src[7] << 24);
+  
+  /* swap 1x1 blocks */
+  t = (x ^ (x >> 7)) & 0x00AA00AAUL;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAUL;
+  y = y ^ t ^ (t << 7);
+  
+  /* swap 2x2 blocks */
+  t = (x ^ (x >> 14)) & 0x0000CCCCUL;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCUL;
+  y = y ^ t ^ (t << 14);
+  
+  /* swap 4x4 blocks between x and y */
+  t = (x ^ (y << 4)) & 0xF0F0F0F0UL;
+  x ^= t;
+  y ^= t >> 4;
+  
+  dest[0] = x;
+  dest[1] = x >> 8;
+  dest[2] = x >> 16;
+  dest[3] = x >> 24;
+  dest[4] = y;
+  dest[5] = y >> 8;
+  dest[6] = y >> 16;
+  dest[7] = y >> 24;
+}
+
+#endif /* U8X8_WITH_FAST_CONVERT */
+
+/*
+  input:
+    cnt tiles (8 bytes each)
+  output:
+    8 pixel rows with 4 bit per pixel (cnt*4 bytes per row, cnt*32 bytes in total)
+    is_left_lower = 0: the left pixel is the upper nibble (SSD1322, SSD1325, SSD1327, ...)
+    is_left_lower = 1: the left pixel is the lower nibble (SSD1320)
+  returns dest
+*/
+uint8_t *u8x8_convert_tiles_to_4bpp(uint8_t *dest, const uint8_t *src, uint8_t cnt, uint8_t is_left_lower)
+{
+  uint8_t *d;
+  uint8_t i, j;
+  uint8_t pitch = cnt*4;
+#ifdef U8X8_WITH_FAST_CONVERT
+  uint8_t rows[8];
+  uint8_t v;
+  const uint8_t *lut = is_left_lower ? u8x8_convert_left_lower : u8x8_convert_left_upper;
+  
+  for( j = 0; j < cnt; j++ )
+  {
+    u8x8_convert_transpose(rows, src);
+    src += 8;
+    d = dest + j*4;
+    for( i = 0; i < 8; i++ )
+    {
+      v = rows[i];
+      d[0] = lut[v & 3];
+      d[1] = lut[(v >> 2) & 3];
+      d[2] = lut[(v >> 4) & 3];
+      d[3] = lut[v >> 6];
+      d += pitch;
+    }
+  }
+#else
+  uint8_t v, a, b;
+  uint8_t ma = 0x0f0;
+  uint8_t mb = 0x00f;
+  
+  if ( is_left_lower )
+  {
+    ma = 0x00f;
+    mb = 0x0f0;
+  }
+  for( j = 0; j < cnt*4; j++ )
+  {
+    d = dest + j;
+    a = *src++;
+    b = *src++;
+    for( i = 0; i < 8; i++ )
+    {
+      v = 0;
+      if ( a&1 ) v |= ma;
+      if ( b&1 ) v |= mb;
+      *d = v;
+      d += pitch;
+      a >>= 1;
+      b >>= 1;
+    }
+  }
+#endif /* U8X8_WITH_FAST_CONVERT */
+  return dest;
+}
+
+/*
+  rotate one tile by 90 degree
+    is_clockwise = 1: the top pixel row of src becomes the right column of dest (U8G2_R1)
+    is_clockwise = 0: the top pixel row of src becomes the left column of dest (U8G2_R3)
+  src and dest must not overlap
+*/
+void u8x8_convert_rotate_tile(uint8_t *dest, const uint8_t *src, uint8_t is_clockwise)
+{
+#ifdef U8X8_WITH_FAST_CONVERT
+  uint8_t tmp[8];
+  uint8_t i;
+  
+  if ( is_clockwise )
+  {
+    u8x8_convert_transpose(tmp, src);
+    for( i = 0; i < 8; i++ )
+      dest[i] = tmp[7-i];
+  }
+  else
+  {
+    for( i = 0; i < 8; i++ )
+      tmp[i] = src[7-i];
+    u8x8_convert_transpose(dest, tmp);
+  }
+#else
+  uint8_t i, j, v;
+  
+  for( i = 0; i < 8; i++ )
+    dest[i] = 0;
+  for( i = 0; i < 8; i++ )
+  {
+    v = src[i];
+    for( j = 0; j < 8; j++ )
+    {
+      if ( v & 1 )
+      {
+	if ( is_clockwise )
+	  dest[7-j] |= 1<<i;
+	else
+	  dest[j] |= 0x080>>i;
+      }
+      v >>= 1;
+    }
+  }
+#endif /* U8X8_WITH_FAST_CONVERT */
+}
@@ -164,10 +164,9 @@ static const u8x8_display_info_t u8x8_il3820_296x128_display_info =
 };
 
 
-static uint8_t *u8x8_convert_tile_for_il3820(uint8_t *t)
+static uint8_t *u8x8_convert_tile_for_il3820(uint8_t *t, uint8_t *buf)
 {
   uint8_t i;
-  static uint8_t buf[8];
   uint8_t *pbuf = buf;
 
   for( i = 0; i < 8; i++ )
@@ -180,6 +179,7 @@ static uint8_t *u8x8_convert_tile_for_il3820(uint8_t *t)
 static void u8x8_d_il3820_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr) U8X8_NOINLINE;
 static void u8x8_d_il3820_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[8];		/* converted tile data */
   uint16_t x;
   uint8_t c, page;
   uint8_t *ptr;
@@ -211,7 +211,7 @@ static void u8x8_d_il3820_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr
     ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
     do
     {
-      u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_il3820(ptr));
+      u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_il3820(ptr, buf));
       ptr += 8;
       x += 8;
       c--;
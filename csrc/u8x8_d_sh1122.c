@@ -105,7 +105,7 @@ static uint8_t *u8x8_sh1122_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
 
 static uint8_t u8x8_write_byte_to_16gr_device(u8x8_t *u8x8, uint8_t b)
 {
-  static uint8_t buf[4];
+  uint8_t buf[4];
   static uint8_t map[4] = { 0, 0x00f, 0x0f0, 0x0ff };
   buf [3] = map[b & 3];
   b>>=2;
@@ -179,6 +179,36 @@ uint8_t u8x8_d_sh1122_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       
       u8x8_cad_EndTransfer(u8x8);
       break;
+#ifdef U8X8_WITH_GRAY4
+    case U8X8_MSG_DISPLAY_DRAW_GRAY4:
+      u8x8_cad_StartTransfer(u8x8);
+      x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
+      x *= 4;		/* column address is the byte address, 4 bytes per tile */
+      x += u8x8->x_offset;		
+    
+      y = (((u8x8_tile_t *)arg_ptr)->y_pos);
+      y *= 8;
+      
+      c = ((u8x8_tile_t *)arg_ptr)->cnt;	/* number of tiles */
+      ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;	/* 4 bit per pixel, same format as the sh1122 memory */
+      do
+      {
+	for( i = 0; i < 8; i++ )
+	{
+	  u8x8_cad_SendCmd(u8x8, 0x0b0 );	/* set row address */
+	  u8x8_cad_SendArg(u8x8, y);
+	  u8x8_cad_SendCmd(u8x8, x & 15 );	/* lower 4 bit*/
+	  u8x8_cad_SendCmd(u8x8, 0x010 | (x >> 4) );	/* higher 3 bit */	  
+	  u8x8_cad_SendData(u8x8, c*4, ptr);
+	  ptr += c*4;
+	  y++;
+	}
+	arg_int--;
+      } while( arg_int > 0 );
+      
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+#endif /* U8X8_WITH_GRAY4 */
     default:
       return 0;
   }
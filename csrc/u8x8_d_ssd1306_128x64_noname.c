@@ -293,6 +293,13 @@ static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       u8x8_cad_SendArg(u8x8, arg_int );	/* ssd1306 has range from 0 to 255 */
       u8x8_cad_EndTransfer(u8x8);
       break;
+#endif
+#ifdef U8X8_WITH_SCROLL
+    case U8X8_MSG_DISPLAY_SET_START_TILE_ROW:
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, 0x040 | (arg_int*8) );
+      u8x8_cad_EndTransfer(u8x8);
+      break;
 #endif
     case U8X8_MSG_DISPLAY_DRAW_TILE:
       u8x8_cad_StartTransfer(u8x8);
@@ -300,11 +307,17 @@ static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       x *= 8;
       x += u8x8->x_offset;
     
+#ifdef U8X8_WITH_SCROLL
+      c = (((u8x8_tile_t *)arg_ptr)->y_pos + u8x8->start_tile_row) & 7;	/* page of the visible tile row */
+      u8x8_cad_SendCmd(u8x8, 0x040 | (u8x8->start_tile_row*8) );	/* set line offset */
+#else
+      c = ((u8x8_tile_t *)arg_ptr)->y_pos;
       u8x8_cad_SendCmd(u8x8, 0x040 );	/* set line offset to 0 */
+#endif
     
       u8x8_cad_SendCmd(u8x8, 0x010 | (x>>4) );
       u8x8_cad_SendArg(u8x8, 0x000 | ((x&15)));					/* probably wrong, should be SendCmd */
-      u8x8_cad_SendArg(u8x8, 0x0b0 | (((u8x8_tile_t *)arg_ptr)->y_pos));	/* probably wrong, should be SendCmd */
+      u8x8_cad_SendArg(u8x8, 0x0b0 | c);	/* probably wrong, should be SendCmd */
 
     
       do
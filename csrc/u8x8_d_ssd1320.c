@@ -64,49 +64,10 @@ static const uint8_t u8x8_d_ssd1320_cs1_160x132_nhd_powersave1_seq[] = {
 };
 
 
-/*
-  input:32
-    one tile (8 Bytes; 1 byte per column)
-  output:
-    Tile for SSD1320 (32 Bytes)
-
-*/
-
-static uint8_t u8x8_ssd1320_to32_dest_buf[32];
-
-
-
-static uint8_t *u8x8_ssd1320_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
-{
-  uint8_t v;
-  uint8_t a,b;
-  uint8_t i, j;
-  uint8_t *dest;
-  
-  for( j = 0; j < 4; j++ )
-  {
-    dest = u8x8_ssd1320_to32_dest_buf;
-    dest += j;
-    a =*ptr;
-    ptr++;
-    b = *ptr;
-    ptr++;
-    for( i = 0; i < 8; i++ )
-    {
-      v = 0;
-      if ( a&1 ) v |= 0x0f;
-      if ( b&1 ) v |= 0xf0;
-      *dest = v;
-      dest+=4;
-      a >>= 1;
-      b >>= 1;
-    }
-  }  
-  return u8x8_ssd1320_to32_dest_buf;
-}
 
 uint8_t u8x8_d_ssd1320_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[32];		/* converted tile data */
   uint8_t x; 
   uint8_t y, c;
   uint8_t *ptr;
@@ -159,7 +120,7 @@ uint8_t u8x8_d_ssd1320_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
           u8x8_cad_SendArg(u8x8, x );	/* start */
           u8x8_cad_SendArg(u8x8, x+3 );	/* end */
           
-          u8x8_cad_SendData(u8x8, 32, u8x8_ssd1320_8to32(u8x8, ptr));
+          u8x8_cad_SendData(u8x8, 32, u8x8_convert_tiles_to_4bpp(buf, ptr, 1, 1));	/* left pixel is the lower nibble */
           
           ptr += 8;
           x += 4;
@@ -182,37 +143,10 @@ uint8_t u8x8_d_ssd1320_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
 
 
 
-static uint8_t *u8x8_ssd1320_8to32_2(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
-{
-  uint8_t v;
-  uint8_t a,b;
-  uint8_t i, j;
-  uint8_t *dest;
-  
-  for( j = 0; j < 4; j++ )
-  {
-    dest = u8x8_ssd1320_to32_dest_buf;
-    dest += j;
-    a =*ptr;
-    ptr++;
-    b = *ptr;
-    ptr++;
-    for( i = 0; i < 8; i++ )
-    {
-      v = 0;
-      if ( a&1 ) v |= 0xf0;     // changed from 0x0f to 0xf0, https://github.com/olikraus/u8g2/issues/1816
-      if ( b&1 ) v |= 0x0f;     // changed from 0xf0 to 0x0f, https://github.com/olikraus/u8g2/issues/1816
-      *dest = v;
-      dest+=4;
-      a >>= 1;
-      b >>= 1;
-    }
-  }
-  return u8x8_ssd1320_to32_dest_buf;
-}
 
 uint8_t u8x8_d_ssd1320_common_2(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[32];		/* converted tile data */
   uint8_t x; 
   uint8_t y, c;
   uint8_t *ptr;
@@ -265,7 +199,7 @@ uint8_t u8x8_d_ssd1320_common_2(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
           u8x8_cad_SendArg(u8x8, x );	/* start */
           u8x8_cad_SendArg(u8x8, x+3 );	/* end */
           
-          u8x8_cad_SendData(u8x8, 32, u8x8_ssd1320_8to32_2(u8x8, ptr));
+          u8x8_cad_SendData(u8x8, 32, u8x8_convert_tiles_to_4bpp(buf, ptr, 1, 0));	/* left pixel is the upper nibble, https://github.com/olikraus/u8g2/issues/1816 */
           
           ptr += 8;
           x += 4;
@@ -83,44 +83,13 @@ static uint8_t u8x8_write_byte_to_16gr_device(u8x8_t *u8x8, uint8_t b)
 
 /*
   input:
-    one tile (8 Bytes)
+    half tile (4 Bytes)
   output:
-    Tile for SSD1325 (32 Bytes)
+    Tile for SSD1322 (32 Bytes), each pixel is doubled
+  The conversion of a complete tile is done by u8x8_convert_tiles_to_4bpp()
 */
 
-static uint8_t u8x8_ssd1322_to32_dest_buf[32];
-
-static uint8_t *u8x8_ssd1322_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
-{
-  uint8_t v;
-  uint8_t a,b;
-  uint8_t i, j;
-  uint8_t *dest;
-  
-  for( j = 0; j < 4; j++ )
-  {
-    dest = u8x8_ssd1322_to32_dest_buf;
-    dest += j;
-    a =*ptr;
-    ptr++;
-    b = *ptr;
-    ptr++;
-    for( i = 0; i < 8; i++ )
-    {
-      v = 0;
-      if ( a&1 ) v |= 0xf0;
-      if ( b&1 ) v |= 0x0f;
-      *dest = v;
-      dest+=4;
-      a >>= 1;
-      b >>= 1;
-    }
-  }
-  
-  return u8x8_ssd1322_to32_dest_buf;
-}
-
-static uint8_t *u8x8_ssd1322_4to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
+static uint8_t *u8x8_ssd1322_4to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr, uint8_t *dest_buf)
 {
   uint8_t v;
   uint8_t a;
@@ -129,7 +98,7 @@ static uint8_t *u8x8_ssd1322_4to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
   
   for( j = 0; j < 4; j++ )
   {
-    dest = u8x8_ssd1322_to32_dest_buf;
+    dest = dest_buf;
     dest += j;
     a =*ptr;
     ptr++;
@@ -143,14 +112,15 @@ static uint8_t *u8x8_ssd1322_4to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
     }
   }
   
-  return u8x8_ssd1322_to32_dest_buf;
+  return dest_buf;
 }
 
 
 uint8_t u8x8_d_ssd1322_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[U8X8_CONVERT_TILE_CNT*32];		/* converted tile data */
   uint8_t x; 
-  uint8_t y, c;
+  uint8_t y, c, n;
   uint8_t *ptr;
   switch(msg)
   {
@@ -198,17 +168,21 @@ uint8_t u8x8_d_ssd1322_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
 
 	do
 	{
+	  n = c;		/* number of tiles for the next memory window */
+	  if ( n > U8X8_CONVERT_TILE_CNT )
+	    n = U8X8_CONVERT_TILE_CNT;
+	  
 	  u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
 	  u8x8_cad_SendArg(u8x8, x );	/* start */
-	  u8x8_cad_SendArg(u8x8, x+1 );	/* end */
+	  u8x8_cad_SendArg(u8x8, x+n*2-1 );	/* end */
 
 	  u8x8_cad_SendCmd(u8x8, 0x05c );	/* write to ram */
 	  
-	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1322_8to32(u8x8, ptr));
+	  u8x8_cad_SendData(u8x8, n*32, u8x8_convert_tiles_to_4bpp(buf, ptr, n, 0));
 	  
-	  ptr += 8;
-	  x += 2;
-	  c--;
+	  ptr += n*8;
+	  x += n*2;
+	  c -= n;
 	} while( c > 0 );
 	
 	//x += 2;
@@ -217,6 +191,40 @@ uint8_t u8x8_d_ssd1322_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
       
       u8x8_cad_EndTransfer(u8x8);
       break;
+#ifdef U8X8_WITH_GRAY4
+    case U8X8_MSG_DISPLAY_DRAW_GRAY4:
+      u8x8_cad_StartTransfer(u8x8);
+      x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
+      x *= 2;		// only every 4th col can be addressed
+      x += u8x8->x_offset;		
+    
+      y = (((u8x8_tile_t *)arg_ptr)->y_pos);
+      y *= 8;
+      
+      c = ((u8x8_tile_t *)arg_ptr)->cnt;
+      ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
+
+      /* one memory window for all tile rows, the data is already in the ssd1322 format */
+      u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
+      u8x8_cad_SendArg(u8x8, x );	/* start */
+      u8x8_cad_SendArg(u8x8, x+c*2-1 );	/* end */
+      u8x8_cad_SendCmd(u8x8, 0x075 );	/* set row address */
+      u8x8_cad_SendArg(u8x8, y);
+      u8x8_cad_SendArg(u8x8, y+arg_int*8-1);
+      u8x8_cad_SendCmd(u8x8, 0x05c );	/* write to ram */
+      
+      y = arg_int;
+      y *= 8;		/* number of pixel rows */
+      do
+      {
+	u8x8_cad_SendData(u8x8, c*4, ptr);	/* one pixel row, the controller continues with the next row */
+	ptr += c*4;
+	y--;
+      } while( y > 0 );
+      
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+#endif /* U8X8_WITH_GRAY4 */
     default:
       return 0;
   }
@@ -438,6 +446,7 @@ uint8_t u8x8_d_ssd1322_240x128(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 
 uint8_t u8x8_d_ssd1322_common2(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[32];		/* converted tile data */
   uint8_t x; 
   uint8_t y, c;
   uint8_t *ptr;
@@ -492,7 +501,7 @@ uint8_t u8x8_d_ssd1322_common2(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 	  u8x8_cad_SendArg(u8x8, x );	/* start */
 	  u8x8_cad_SendArg(u8x8, x+1 );	/* end */
 	  u8x8_cad_SendCmd(u8x8, 0x05c );	/* write to ram */	  
-	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1322_4to32(u8x8, ptr));	  
+	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1322_4to32(u8x8, ptr, buf));	  
 	  ptr += 4;
 	  x += 2;
 	  
@@ -500,7 +509,7 @@ uint8_t u8x8_d_ssd1322_common2(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
 	  u8x8_cad_SendArg(u8x8, x );	/* start */
 	  u8x8_cad_SendArg(u8x8, x+1 );	/* end */
 	  u8x8_cad_SendCmd(u8x8, 0x05c );	/* write to ram */	  
-	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1322_4to32(u8x8, ptr));	  
+	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1322_4to32(u8x8, ptr, buf));	  
 	  ptr += 4;
 	  x += 2;
 	  
@@ -111,50 +111,13 @@ static const uint8_t u8x8_d_ssd1326_256x32_nhd_flip1_seq[] = {
 };
 
 
-/*
-  input:
-    one tile (8 Bytes)
-  output:
-    Tile for ssd1326 (32 Bytes)
-*/
-
-static uint8_t u8x8_ssd1326_8to32_dest_buf[32];
-
-static uint8_t *u8x8_ssd1326_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
-{
-  uint8_t v;
-  uint8_t a,b;
-  uint8_t i, j;
-  uint8_t *dest;
-  
-  for( j = 0; j < 4; j++ )
-  {
-    dest = u8x8_ssd1326_8to32_dest_buf;
-    dest += j;
-    a =*ptr;
-    ptr++;
-    b = *ptr;
-    ptr++;
-    for( i = 0; i < 8; i++ )
-    {
-      v = 0;
-      if ( a&1 ) v |= 0xf0;
-      if ( b&1 ) v |= 0x0f;
-      *dest = v;
-      dest+=4;
-      a >>= 1;
-      b >>= 1;
-    }
-  }
-  
-  return u8x8_ssd1326_8to32_dest_buf;
-}
 
 
 
 
 static uint8_t u8x8_d_ssd1326_256x32_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[32];		/* converted tile data */
   uint8_t x, y, c;
   uint8_t *ptr;
   switch(msg)
@@ -220,7 +183,7 @@ static uint8_t u8x8_d_ssd1326_256x32_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
           u8x8_cad_SendArg(u8x8, y);
           u8x8_cad_SendArg(u8x8, y+7);
           
-          u8x8_cad_SendData(u8x8, 32, u8x8_ssd1326_8to32(u8x8, ptr));
+          u8x8_cad_SendData(u8x8, 32, u8x8_convert_tiles_to_4bpp(buf, ptr, 1, 0));
           
 	  ptr += 8;
 	  x += 4;
@@ -85,51 +85,12 @@ static const uint8_t u8x8_d_ssd1327_winstar_96x64_flip1_seq[] = {
   U8X8_END()             			/* end of sequence */
 };
 
-/*
-  input:
-    one tile (8 Bytes)
-  output:
-    Tile for ssd1327 (32 Bytes)
-*/
-
-static uint8_t u8x8_ssd1327_8to32_dest_buf[32];
-
-static uint8_t *u8x8_ssd1327_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
-{
-  uint8_t v;
-  uint8_t a,b;
-  uint8_t i, j;
-  uint8_t *dest;
-  
-  for( j = 0; j < 4; j++ )
-  {
-    dest = u8x8_ssd1327_8to32_dest_buf;
-    dest += j;
-    a =*ptr;
-    ptr++;
-    b = *ptr;
-    ptr++;
-    for( i = 0; i < 8; i++ )
-    {
-      v = 0;
-      if ( a&1 ) v |= 0xf0;
-      if ( b&1 ) v |= 0x0f;
-      *dest = v;
-      dest+=4;
-      a >>= 1;
-      b >>= 1;
-    }
-  }
-  
-  return u8x8_ssd1327_8to32_dest_buf;
-}
-
-
-
+/* tiles are converted by u8x8_convert_tiles_to_4bpp() */
 
 static uint8_t u8x8_d_ssd1327_96x96_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  uint8_t x, y, c;
+  uint8_t buf[U8X8_CONVERT_TILE_CNT*32];		/* converted tile data */
+  uint8_t x, y, c, n;
   uint8_t *ptr;
   switch(msg)
   {
@@ -179,15 +140,19 @@ static uint8_t u8x8_d_ssd1327_96x96_generic(u8x8_t *u8x8, uint8_t msg, uint8_t a
 
 	do
 	{
+	  n = c;		/* number of tiles for the next memory window */
+	  if ( n > U8X8_CONVERT_TILE_CNT )
+	    n = U8X8_CONVERT_TILE_CNT;
+	  
 	  u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
 	  u8x8_cad_SendArg(u8x8, x );	/* start */
-	  u8x8_cad_SendArg(u8x8, x+3 );	/* end */
+	  u8x8_cad_SendArg(u8x8, x+n*4-1 );	/* end */
 
 	  
-	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1327_8to32(u8x8, ptr));
-	  ptr += 8;
-	  x += 4;
-	  c--;
+	  u8x8_cad_SendData(u8x8, n*32, u8x8_convert_tiles_to_4bpp(buf, ptr, n, 0));
+	  ptr += n*8;
+	  x += n*4;
+	  c -= n;
 	} while( c > 0 );
 	
 	//x += 4;
@@ -196,6 +161,39 @@ static uint8_t u8x8_d_ssd1327_96x96_generic(u8x8_t *u8x8, uint8_t msg, uint8_t a
       
       u8x8_cad_EndTransfer(u8x8);
       break;
+#ifdef U8X8_WITH_GRAY4
+    case U8X8_MSG_DISPLAY_DRAW_GRAY4:
+      u8x8_cad_StartTransfer(u8x8);
+      x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
+      x *= 4;
+      x+=u8x8->x_offset/2;
+    
+      y = (((u8x8_tile_t *)arg_ptr)->y_pos);
+      y *= 8;
+      
+      c = ((u8x8_tile_t *)arg_ptr)->cnt;
+      ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
+
+      /* one memory window for all tile rows, the data is already in the ssd1327 format */
+      u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
+      u8x8_cad_SendArg(u8x8, x );	/* start */
+      u8x8_cad_SendArg(u8x8, x+c*4-1 );	/* end */
+      u8x8_cad_SendCmd(u8x8, 0x075 );	/* set row address */
+      u8x8_cad_SendArg(u8x8, y);
+      u8x8_cad_SendArg(u8x8, y+arg_int*8-1);
+      
+      y = arg_int;
+      y *= 8;		/* number of pixel rows */
+      do
+      {
+	u8x8_cad_SendData(u8x8, c*4, ptr);	/* one pixel row, the controller continues with the next row */
+	ptr += c*4;
+	y--;
+      } while( y > 0 );
+      
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+#endif /* U8X8_WITH_GRAY4 */
     default:
       return 0;
   }
@@ -65,47 +65,9 @@ static const uint8_t u8x8_d_ssd1362_powersave1_seq[] = {
 
 
 
-/*
-  input:
-    one tile (8 Bytes)
-  output:
-    Tile for SSD1362 (32 Bytes)
-*/
-
-static uint8_t u8x8_ssd1362_to32_dest_buf[32];
-
-static uint8_t *u8x8_ssd1362_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
-{
-  uint8_t v;
-  uint8_t a,b;
-  uint8_t i, j;
-  uint8_t *dest;
-  
-  for( j = 0; j < 4; j++ )
-  {
-    dest = u8x8_ssd1362_to32_dest_buf;
-    dest += j;
-    a =*ptr;
-    ptr++;
-    b = *ptr;
-    ptr++;
-    for( i = 0; i < 8; i++ )
-    {
-      v = 0;
-      if ( a&1 ) v |= 0xf0;
-      if ( b&1 ) v |= 0x0f;
-      *dest = v;
-      dest+=4;
-      a >>= 1;
-      b >>= 1;
-    }
-  }
-  
-  return u8x8_ssd1362_to32_dest_buf;
-}
 
 /* special case for the 206x36 display: send only half of the last tile */
-static uint8_t *u8x8_ssd1362_8to24(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
+static uint8_t *u8x8_ssd1362_8to24(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr, uint8_t *dest_buf)
 {
   uint8_t v;
   uint8_t a,b;
@@ -114,7 +76,7 @@ static uint8_t *u8x8_ssd1362_8to24(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
   
   for( j = 0; j < 3; j++ )
   {
-    dest = u8x8_ssd1362_to32_dest_buf;
+    dest = dest_buf;
     dest += j;
     a =*ptr;
     ptr++;
@@ -132,12 +94,13 @@ static uint8_t *u8x8_ssd1362_8to24(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
     }
   }
   
-  return u8x8_ssd1362_to32_dest_buf;
+  return dest_buf;
 }
 
 
 uint8_t u8x8_d_ssd1362_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[32];		/* converted tile data */
   uint8_t x; 
   uint8_t y, c;
   uint8_t *ptr;
@@ -190,7 +153,7 @@ uint8_t u8x8_d_ssd1362_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
 	  u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
           u8x8_cad_SendArg(u8x8, x );	/* start */
           u8x8_cad_SendArg(u8x8, x+3 );	/* end */
-          u8x8_cad_SendData(u8x8, 32, u8x8_ssd1362_8to32(u8x8, ptr));
+          u8x8_cad_SendData(u8x8, 32, u8x8_convert_tiles_to_4bpp(buf, ptr, 1, 0));
 	  
 	  ptr += 8;
 	  x += 4;
@@ -212,6 +175,7 @@ uint8_t u8x8_d_ssd1362_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
 
 uint8_t u8x8_d_ssd1362_common_0_75(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[32];		/* converted tile data */
   uint8_t x; 
   uint8_t y, c;
   uint8_t *ptr;
@@ -266,13 +230,13 @@ uint8_t u8x8_d_ssd1362_common_0_75(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, v
           {
             u8x8_cad_SendArg(u8x8, x );	/* start */
             u8x8_cad_SendArg(u8x8, x+3 );	/* end */
-            u8x8_cad_SendData(u8x8, 32, u8x8_ssd1362_8to32(u8x8, ptr));
+            u8x8_cad_SendData(u8x8, 32, u8x8_convert_tiles_to_4bpp(buf, ptr, 1, 0));
           }
           else
           {
             u8x8_cad_SendArg(u8x8, x );	/* start */
             u8x8_cad_SendArg(u8x8, x+2 );	/* end */
-            u8x8_cad_SendData(u8x8, 24, u8x8_ssd1362_8to24(u8x8, ptr));
+            u8x8_cad_SendData(u8x8, 24, u8x8_ssd1362_8to24(u8x8, ptr, buf));
           }
 	  
 	  ptr += 8;
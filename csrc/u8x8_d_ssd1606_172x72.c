@@ -205,11 +205,10 @@ static const uint8_t u8x8_d_ssd1606_to_display_seq[] = {
 // };
 
 
-static uint8_t *u8x8_convert_tile_for_ssd1606(uint8_t *t)
+static uint8_t *u8x8_convert_tile_for_ssd1606(uint8_t *t, uint8_t *buf)
 {
   uint8_t i;
   uint16_t r;
-  static uint8_t buf[16];
   uint8_t *pbuf = buf;
 
   for( i = 0; i < 8; i++ )
@@ -224,6 +223,7 @@ static uint8_t *u8x8_convert_tile_for_ssd1606(uint8_t *t)
 static void u8x8_d_ssd1606_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr) U8X8_NOINLINE;
 static void u8x8_d_ssd1606_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[16];		/* converted tile data */
   uint8_t x, c, page;
   uint8_t *ptr;
   u8x8_cad_StartTransfer(u8x8);
@@ -266,7 +266,7 @@ static void u8x8_d_ssd1606_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_pt
     ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
     do
     {
-      u8x8_cad_SendData(u8x8, 16, u8x8_convert_tile_for_ssd1606(ptr));
+      u8x8_cad_SendData(u8x8, 16, u8x8_convert_tile_for_ssd1606(ptr, buf));
       ptr += 8;
       x += 8;
       c--;
@@ -85,14 +85,13 @@ static const uint8_t u8x8_d_st7528_flip1_seq[] = {
     Tile for st7528 (32 Bytes)
 */
 
-static uint8_t u8x8_st7528_8to32_dest_buf[32];
 
-static uint8_t *u8x8_st7528_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
+static uint8_t *u8x8_st7528_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr, uint8_t *dest_buf)
 {
   uint8_t j;
   uint8_t *dest;
   
-  dest = u8x8_st7528_8to32_dest_buf;
+  dest = dest_buf;
   for( j = 0; j < 8; j++ )
   {
     *dest++ =*ptr;
@@ -101,13 +100,14 @@ static uint8_t *u8x8_st7528_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
     *dest++ =*ptr;
     ptr++;
   }
-  return u8x8_st7528_8to32_dest_buf;
+  return dest_buf;
 }
 
 
 
 static uint8_t u8x8_d_st7528_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[32];		/* converted tile data */
   uint8_t x;
   uint8_t y, c;
   uint8_t *ptr;
@@ -168,7 +168,7 @@ static uint8_t u8x8_d_st7528_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
           u8x8_cad_SendCmd(u8x8, 0x10| (x>>4) );	/* set col msb*/
           u8x8_cad_SendCmd(u8x8, 0x00| (x&15) );	/* set col lsb*/
           
-          u8x8_cad_SendData(u8x8, 32, u8x8_st7528_8to32(u8x8, ptr));
+          u8x8_cad_SendData(u8x8, 32, u8x8_st7528_8to32(u8x8, ptr, buf));
           
 	  ptr += 8;
 	  x += 8;
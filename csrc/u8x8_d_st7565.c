@@ -126,7 +126,11 @@ uint8_t u8x8_d_st7565_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       x += u8x8->x_offset;
       u8x8_cad_SendCmd(u8x8, 0x010 | (x>>4) );
       u8x8_cad_SendCmd(u8x8, 0x000 | ((x&15)));
+#ifdef U8X8_WITH_SCROLL
+      u8x8_cad_SendCmd(u8x8, 0x0b0 | ((((u8x8_tile_t *)arg_ptr)->y_pos + u8x8->start_tile_row) & 7));
+#else
       u8x8_cad_SendCmd(u8x8, 0x0b0 | (((u8x8_tile_t *)arg_ptr)->y_pos));
+#endif
     
       c = ((u8x8_tile_t *)arg_ptr)->cnt;
       c *= 8;
@@ -149,6 +153,16 @@ uint8_t u8x8_d_st7565_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       
       u8x8_cad_EndTransfer(u8x8);
       break;
+#ifdef U8X8_WITH_SCROLL
+    case U8X8_MSG_DISPLAY_SET_START_TILE_ROW:
+      /* the start line wraps around after 64 lines, the 65th (icon) line is not part of the ring */
+      if ( u8x8->display_info->tile_height != 8 )
+	return 0;
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, 0x040 | (arg_int*8) );
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+#endif
     /*	handled in the calling procedure 
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
       u8x8_d_helper_display_setup_memory(u8x8, &u8x8_st7565_128x64_display_info);
@@ -748,6 +762,11 @@ static const u8x8_display_info_t u8x8_st7565_lm6059_display_info =
 
 uint8_t u8x8_d_st7565_lm6059(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+#ifdef U8X8_WITH_SCROLL
+  /* the init sequence uses start line 32, scrolling is not supported */
+  if ( msg == U8X8_MSG_DISPLAY_SET_START_TILE_ROW )
+    return 0;
+#endif
   /* call common procedure first and handle messages there */
   if ( u8x8_d_st7565_common(u8x8, msg, arg_int, arg_ptr) == 0 )
   {
@@ -895,6 +914,11 @@ static const u8x8_display_info_t u8x8_st7565_lx12864_display_info =
 
 uint8_t u8x8_d_st7565_lx12864(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+#ifdef U8X8_WITH_SCROLL
+  /* the init sequence uses start line 32, scrolling is not supported */
+  if ( msg == U8X8_MSG_DISPLAY_SET_START_TILE_ROW )
+    return 0;
+#endif
   /* call common procedure first and handle messages there */
   if ( u8x8_d_st7565_common(u8x8, msg, arg_int, arg_ptr) == 0 )
   {
@@ -1154,6 +1178,11 @@ static const uint8_t u8x8_d_nt7534_tg12864r_init_seq[] = {
 
 uint8_t u8x8_d_nt7534_tg12864r(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+#ifdef U8X8_WITH_SCROLL
+  /* the init sequence uses start line 32, scrolling is not supported */
+  if ( msg == U8X8_MSG_DISPLAY_SET_START_TILE_ROW )
+    return 0;
+#endif
   /* call common procedure first and handle messages there */
   if ( u8x8_d_st7565_common(u8x8, msg, arg_int, arg_ptr) == 0 )
   {
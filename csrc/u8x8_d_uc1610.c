@@ -187,11 +187,10 @@ static const u8x8_display_info_t u8x8_uc1610_display_info =
 
 
 */
-static uint8_t *u8x8_convert_tile_for_uc1610(uint8_t *t)
+static uint8_t *u8x8_convert_tile_for_uc1610(uint8_t *t, uint8_t *buf)
 {
   uint8_t i;
   uint16_t r;
-  static uint8_t buf[16];
   uint8_t *pbuf = buf;
 
   for( i = 0; i < 8; i++ )
@@ -206,6 +205,7 @@ static uint8_t *u8x8_convert_tile_for_uc1610(uint8_t *t)
 
 uint8_t u8x8_d_uc1610_ea_dogxl160(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[16];		/* converted tile data */
   uint8_t x, c, page;
   uint8_t *ptr;
   switch(msg)
@@ -275,7 +275,7 @@ uint8_t u8x8_d_uc1610_ea_dogxl160(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
 	ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
 	do
 	{
-	  u8x8_cad_SendData(u8x8, 16, u8x8_convert_tile_for_uc1610(ptr));
+	  u8x8_cad_SendData(u8x8, 16, u8x8_convert_tile_for_uc1610(ptr, buf));
 	  ptr += 8;
 	  x += 8;
 	  c--;
@@ -84,30 +84,29 @@ static uint8_t u8x8_upscale_4bit(uint8_t x)
 	return y;
 }
 
-static uint8_t u8x8_uc1617_tile_half_buffer[8];
 
-static uint8_t *u8x8_convert_tile_for_uc1617_lower4bit(uint8_t *t)
+static uint8_t *u8x8_convert_tile_for_uc1617_lower4bit(uint8_t *t, uint8_t *dest_buf)
 {
   uint8_t i;
-  uint8_t *pbuf = u8x8_uc1617_tile_half_buffer;
+  uint8_t *pbuf = dest_buf;
 
   for( i = 0; i < 8; i++ )
   {
     *pbuf++ = u8x8_upscale_4bit(*t++);
   }
-  return u8x8_uc1617_tile_half_buffer;
+  return dest_buf;
 }
 
-static uint8_t *u8x8_convert_tile_for_uc1617_upper4bit(uint8_t *t)
+static uint8_t *u8x8_convert_tile_for_uc1617_upper4bit(uint8_t *t, uint8_t *dest_buf)
 {
   uint8_t i;
-  uint8_t *pbuf = u8x8_uc1617_tile_half_buffer;
+  uint8_t *pbuf = dest_buf;
 
   for( i = 0; i < 8; i++ )
   {
     *pbuf++ = u8x8_upscale_4bit((*t++)>>4);
   }
-  return u8x8_uc1617_tile_half_buffer;
+  return dest_buf;
 }
 
 #ifdef NOT_USED
@@ -134,6 +133,7 @@ static uint8_t *u8x8_convert_tile_for_uc1617(uint8_t *t)
 
 uint8_t u8x8_d_uc1617_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+  uint8_t buf[8];		/* converted tile data */
   uint8_t x, y, c, a;
   uint8_t *ptr;
   switch(msg)
@@ -173,7 +173,7 @@ uint8_t u8x8_d_uc1617_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 	ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
 	do
 	{
-	  u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_uc1617_lower4bit(ptr));
+	  u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_uc1617_lower4bit(ptr, buf));
 	  ptr += 8;
 	  x += 8;
 	  c--;
@@ -194,7 +194,7 @@ uint8_t u8x8_d_uc1617_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 	ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
 	do
 	{
-	  u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_uc1617_upper4bit(ptr));
+	  u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_uc1617_upper4bit(ptr, buf));
 	  ptr += 8;
 	  x += 8;
 	  c--;
@@ -74,6 +74,9 @@ void u8x8_d_helper_display_init(u8x8_t *u8x8)
       u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, u8x8->display_info->reset_pulse_width_ms);
       u8x8_gpio_SetReset(u8x8, 1);
       u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, u8x8->display_info->post_reset_wait_ms);
+#ifdef U8X8_WITH_SCROLL
+      u8x8->start_tile_row = 0;	/* reset will also reset the start line of the controller */
+#endif
 }    
 
 /*==========================================*/
@@ -89,6 +92,48 @@ uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *
   return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
 }
 
+#ifdef U8X8_WITH_GRAY4
+/*
+  Write cnt tiles in each of rows tile rows with 4 bit per pixel,
+  see U8X8_MSG_DISPLAY_DRAW_GRAY4
+*/
+uint8_t u8x8_DrawGray4(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *ptr)
+{
+  u8x8_tile_t tile;
+  tile.x_pos = x;
+  tile.y_pos = y;
+  tile.cnt = cnt;
+  tile.tile_ptr = ptr;
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_GRAY4, rows, (void *)&tile);
+}
+#endif /* U8X8_WITH_GRAY4 */
+
+#ifdef U8X8_WITH_SCROLL
+/*
+  Move the visible content of the display cnt tile rows up (cnt > 0) or
+  down (cnt < 0), see U8X8_MSG_DISPLAY_SET_START_TILE_ROW.
+  The tile rows which appear at the bottom (top) of the display will
+  show the old content of the rows which disappeared at the top (bottom).
+  Only these rows have to be redrawn.
+  Returns 0 if the display does not support this and nothing has been changed.
+*/
+uint8_t u8x8_ScrollTileRows(u8x8_t *u8x8, int8_t cnt)
+{
+  uint8_t h = u8x8->display_info->tile_height;
+  uint8_t row;
+  cnt %= (int8_t)h;
+  if ( cnt < 0 )
+    cnt += h;
+  row = u8x8->start_tile_row + (uint8_t)cnt;
+  if ( row >= h )
+    row -= h;
+  if ( u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_START_TILE_ROW, row, NULL) == 0 )
+    return 0;
+  u8x8->start_tile_row = row;
+  return 1;
+}
+#endif /* U8X8_WITH_SCROLL */
+
 /* should be implemented as macro */
 void u8x8_SetupMemory(u8x8_t *u8x8)
 {
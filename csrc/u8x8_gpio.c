@@ -39,6 +39,11 @@
 
 void u8x8_gpio_call(u8x8_t *u8x8, uint8_t msg, uint8_t arg)
 {
+#ifdef U8X8_WITH_TRANSFER_BUFFER
+  /* send pending bytes before any GPIO change or delay */
+  if ( u8x8->byte_cb == u8x8_byte_transfer_buffer )
+    u8x8_byte_FlushTransferBuffer(u8x8);
+#endif
   u8x8->gpio_and_delay_cb(u8x8, msg, arg, NULL);
 }
 
@@ -104,7 +104,15 @@ void u8x8_SetupDefaults(u8x8_t *u8x8)
     u8x8->utf8_state = 0;		/* also reset by u8x8_utf8_init */
     u8x8->bus_clock = 0;		/* issue 769 */
     u8x8->i2c_address = 255;
+    u8x8->i2c_max_transfer = 24;	/* Arduino Wire buffer (32 bytes) minus some reserve, see u8x8_cad.c */
+    u8x8->cad_in_transfer = 0;
+    u8x8->cad_is_data = 0;
+    u8x8->cad_transfer_cnt = 0;
+    u8x8->byte_state = 0;
     u8x8->debounce_default_pin_state = 255;	/* assume all low active buttons */
+#ifdef U8X8_WITH_SCROLL
+    u8x8->start_tile_row = 0;
+#endif
   
 #ifdef U8X8_USE_PINS 
   {
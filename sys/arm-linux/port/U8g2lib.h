@@ -162,6 +162,22 @@ public:
 	void doneSpi(void) {
 		done_spi();
 	}
+	int initAsyncFlush(uint8_t policy) {
+		return init_async_flush(&u8g2, policy);
+	}
+	uint8_t sendBufferAsync(void) {
+		return send_buffer_async(&u8g2);
+	}
+	void waitAsyncFlush(void) {
+		wait_async_flush(&u8g2);
+	}
+	void doneAsyncFlush(void) {
+		done_async_flush(&u8g2);
+	}
+	int renderParallel(void (*draw)(u8g2_t *u8g2, void *arg), void *arg,
+			uint8_t thread_cnt) {
+		return render_parallel(&u8g2, draw, arg, thread_cnt);
+	}
 	void sleepMs(unsigned long milliseconds) {
 		sleep_ms(milliseconds);
 	}
@@ -209,6 +225,10 @@ public:
 		u8g2_SetDisplayRotation(&u8g2, u8g2_cb);
 	}
 
+	uint8_t setFlushRotation(const u8g2_cb_t *u8g2_cb) {
+		return u8g2_SetFlushRotation(&u8g2, u8g2_cb);
+	}
+
 	void begin(void) {
 		initDisplay();
 		clearDisplay();
@@ -270,6 +290,9 @@ public:
 	uint8_t nextPage(void) {
 		return u8g2_NextPage(&u8g2);
 	}
+	void firstPageArea(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+		u8g2_FirstPageArea(&u8g2, x, y, w, h);
+	}
 
 #ifdef U8G2_USE_DYNAMIC_ALLOC
     void setBufferPtr(uint8_t *buf) { u8g2_SetBufferPtr(&u8g2, buf); }
@@ -390,6 +413,25 @@ public:
 		u8g2_DrawXBMP(&u8g2, x, y, w, h, bitmap);
 	}
 
+	/* u8g2_surface.c */
+	void setupSurface(uint8_t *buf, u8g2_uint_t width, u8g2_uint_t height) {
+		u8g2_SetupSurface(&u8g2, buf, width, height,
+				u8g2_ll_hvline_vertical_top_lsb);
+	}
+	void bitBlt(u8g2_uint_t dx, u8g2_uint_t dy, U8G2 &src, u8g2_uint_t sx,
+			u8g2_uint_t sy, u8g2_uint_t w, u8g2_uint_t h, uint8_t rop) {
+		u8g2_BitBlt(&u8g2, dx, dy, src.getU8g2(), sx, sy, w, h, rop);
+	}
+
+	/* u8g2_scroll.c */
+	void scrollBuffer(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h,
+			int16_t dx, int16_t dy) {
+		u8g2_ScrollBuffer(&u8g2, x, y, w, h, dx, dy);
+	}
+	uint8_t scrollDisplay(int8_t tile_rows) {
+		return u8g2_ScrollDisplay(&u8g2, tile_rows);
+	}
+
 	/* u8g2_polygon.c */
 	void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 			int16_t x2, int16_t y2) {
@@ -638,13 +680,10 @@ public:
 		return 1;
 	}
 
+	/* the log is redrawn only once for the complete buffer */
 	size_t write(const uint8_t *buffer, size_t size) {
-		size_t cnt = 0;
-		while (size > 0) {
-			cnt += write(*buffer++);
-			size--;
-		}
-		return cnt;
+		u8log_WriteBuffer(&u8log, buffer, size);
+		return size;
 	}
 
 	void writeString(const char *s) {
@@ -51,12 +51,21 @@ user_data_t* init_user_data(u8g2_t *u8g2) {
 	// Dynamically allocate user data_struct
 	user_data_t *user_data = (user_data_t*) malloc(sizeof(user_data_t));
 	// Dynamically allocate internal buffer
-	user_data->int_buf = (uint8_t*)malloc(u8g2_GetBufferSize(u8g2));
+	user_data->int_buf_size = u8g2_GetBufferSize(u8g2);
+	user_data->int_buf = (uint8_t*)malloc(user_data->int_buf_size);
 	// We need a unique buffer for each display in order to be thread friendly
 	u8g2_SetBufferPtr(u8g2, user_data->int_buf);
 	for (int i = 0; i < U8X8_PIN_CNT; ++i) {
 		user_data->pins[i] = NULL;
 	}
+	user_data->spi_cnt = 0;
+	user_data->spi_len = 0;
+	user_data->spi_buf_len = 0;
+	user_data->spi_dc = 255;
+	user_data->async_buf = NULL;
+	user_data->async_frame = NULL;
+	user_data->async_is_sent = 0;
+	user_data->async_dropped = 0;
 	u8g2_SetUserPtr(u8g2, user_data);
 	return user_data;
 }
@@ -128,6 +137,8 @@ void init_spi_sw(u8g2_t *u8g2, uint8_t gpio_chip, uint8_t dc, uint8_t res,
 void done_user_data(u8g2_t *u8g2) {
 	user_data_t *user_data = u8g2_GetUserPtr(u8g2);
 	if (user_data != NULL) {
+		// Stop the worker thread of send_buffer_async()
+		done_async_flush(u8g2);
 		// Close all GPIO pins
 		for (int i = 0; i < U8X8_PIN_CNT; ++i) {
 			if (user_data->pins[i] != NULL) {
@@ -261,6 +272,62 @@ void done_spi() {
 	}
 }
 
+/*
+ * Send all queued SPI transfers with one SPI_IOC_MESSAGE.
+ */
+void flush_spi(u8x8_t *u8x8) {
+	user_data_t *user_data = u8x8_GetUserPtr(u8x8);
+	if (user_data->spi_cnt > 0) {
+		if (ioctl(spi_fd(spi_handles[user_data->bus]),
+				SPI_IOC_MESSAGE(user_data->spi_cnt),
+				user_data->spi_transfers) < 0) {
+			perror("SPI_IOC_MESSAGE");
+		}
+		user_data->spi_cnt = 0;
+		user_data->spi_len = 0;
+		user_data->spi_buf_len = 0;
+	}
+}
+
+/*
+ * Append data to the queued SPI transfers. Data inside the internal buffers
+ * (the u8g2 tile buffers) is not modified during a transfer and is sent
+ * without copy. All other data (command bytes, data converted by the
+ * display driver) is copied to spi_buf, because the caller may reuse the
+ * memory. Adjacent data is merged into one transfer.
+ */
+static void queue_spi(u8x8_t *u8x8, uint8_t *data, uint8_t len) {
+	user_data_t *user_data = u8x8_GetUserPtr(u8x8);
+	struct spi_ioc_transfer *transfer;
+	uint8_t *dest;
+
+	if (user_data->spi_len + len > MAX_SPI_MESSAGE_LEN
+			|| user_data->spi_cnt >= MAX_SPI_TRANSFERS) {
+		flush_spi(u8x8);
+	}
+	if ((data >= user_data->int_buf
+			&& data + len <= user_data->int_buf + user_data->int_buf_size)
+			|| (user_data->async_buf != NULL && data >= user_data->async_buf
+			&& data + len <= user_data->async_buf + user_data->async_buf_size)) {
+		dest = data;
+	} else {
+		dest = user_data->spi_buf + user_data->spi_buf_len;
+		memcpy(dest, data, len);
+		user_data->spi_buf_len += len;
+	}
+	transfer = user_data->spi_transfers + user_data->spi_cnt;
+	if (user_data->spi_cnt > 0
+			&& (uint8_t*) (uintptr_t) transfer[-1].tx_buf + transfer[-1].len == dest) {
+		transfer[-1].len += len;
+	} else {
+		memset(transfer, 0, sizeof(struct spi_ioc_transfer));
+		transfer->tx_buf = (uintptr_t) dest;
+		transfer->len = len;
+		user_data->spi_cnt++;
+	}
+	user_data->spi_len += len;
+}
+
 /**
  * GPIO callback.
  */
@@ -269,6 +336,8 @@ uint8_t u8x8_arm_linux_gpio_and_delay(u8x8_t *u8x8, uint8_t msg,
 	user_data_t *user_data;
 
 	(void) arg_ptr; /* suppress unused parameter warning */
+	// Queued SPI data must be sent before any delay or GPIO change
+	flush_spi(u8x8);
 	switch (msg) {
 	case U8X8_MSG_DELAY_NANO:
 		// delay arg_int * 1 nano second or 0 for none
@@ -448,24 +517,18 @@ uint8_t u8x8_byte_arm_linux_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 
 /*
  * SPI callback.
+ *
+ * All bytes between start and end of a transfer are queued and sent with
+ * one SPI_IOC_MESSAGE. The DC line is a GPIO, which can not change during
+ * a SPI_IOC_MESSAGE, so the queue is also sent if the DC level changes.
  */
 uint8_t u8x8_byte_arm_linux_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 		void *arg_ptr) {
 	user_data_t *user_data;
-	uint8_t *data;
 
 	switch (msg) {
 	case U8X8_MSG_BYTE_SEND:
-		user_data = u8x8_GetUserPtr(u8x8);
-		user_data->index = 0;
-		data = (uint8_t*) arg_ptr;
-		while (arg_int > 0) {
-			user_data->buffer[user_data->index++] = *data;
-			data++;
-			arg_int--;
-		}
-		spi_transfer(spi_handles[user_data->bus], user_data->buffer,
-				user_data->buffer, user_data->index);
+		queue_spi(u8x8, (uint8_t*) arg_ptr, arg_int);
 		break;
 
 	case U8X8_MSG_BYTE_INIT:
@@ -473,13 +536,19 @@ uint8_t u8x8_byte_arm_linux_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 		break;
 
 	case U8X8_MSG_BYTE_SET_DC:
-		u8x8_gpio_SetDC(u8x8, arg_int);
+		user_data = u8x8_GetUserPtr(u8x8);
+		if (user_data->spi_dc != arg_int) {
+			// flush_spi() is called by the GPIO callback
+			u8x8_gpio_SetDC(u8x8, arg_int);
+			user_data->spi_dc = arg_int;
+		}
 		break;
 
 	case U8X8_MSG_BYTE_START_TRANSFER:
 		break;
 
 	case U8X8_MSG_BYTE_END_TRANSFER:
+		flush_spi(u8x8);
 		break;
 
 	default:
@@ -487,3 +556,340 @@ uint8_t u8x8_byte_arm_linux_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 	}
 	return 1;
 }
+
+/*
+ * Size of the tile buffer of the display, also for u8g2_SetGray4Buffer().
+ */
+static size_t get_tile_buf_size(u8g2_t *u8g2) {
+#ifdef U8G2_WITH_GRAY4
+	if (u8g2->is_gray4_buffer) {
+		return u8g2_GetGray4BufferSize(u8g2, u8g2_GetBufferTileHeight(u8g2));
+	}
+#endif
+	return u8g2_GetBufferSize(u8g2);
+}
+
+/*
+ * Copy the state of the last transfer of the worker thread back into the
+ * u8g2 structure: The cad and byte procedures store the bus state in u8x8 and
+ * the shadow buffer is valid after the frame has been sent. The worker thread
+ * must be idle (async_mutex locked).
+ */
+static void sync_async_flush(u8g2_t *u8g2) {
+	user_data_t *user_data = u8g2_GetUserPtr(u8g2);
+	if (!user_data->async_is_sent) {
+		return;
+	}
+	u8g2->u8x8 = user_data->async_u8g2.u8x8;
+#ifdef U8G2_WITH_SHADOW_BUFFER
+	// Keep u8g2_InvalidateShadowBuffer() calls since send_buffer_async()
+	u8g2->is_shadow_buf_invalid |= user_data->async_u8g2.is_shadow_buf_invalid;
+#endif
+	user_data->async_is_sent = 0;
+}
+
+/*
+ * Worker thread of send_buffer_async(): Send the tile buffer async_frame to
+ * the display with u8g2_SendBuffer() on the copy async_u8g2, so shadow buffer,
+ * gray buffer, flush rotation and page area are handled like in the caller.
+ */
+static void* async_flush_thread(void *arg) {
+	u8g2_t *u8g2 = (u8g2_t*) arg;
+	user_data_t *user_data = u8g2_GetUserPtr(u8g2);
+
+	pthread_mutex_lock(&user_data->async_mutex);
+	for (;;) {
+		while (user_data->async_state == ASYNC_FLUSH_IDLE) {
+			pthread_cond_wait(&user_data->async_cond, &user_data->async_mutex);
+		}
+		if (user_data->async_state == ASYNC_FLUSH_QUIT) {
+			break;
+		}
+		pthread_mutex_unlock(&user_data->async_mutex);
+
+		u8g2_SendBuffer(&user_data->async_u8g2);
+
+		pthread_mutex_lock(&user_data->async_mutex);
+		user_data->async_is_sent = 1;
+		user_data->async_state = ASYNC_FLUSH_IDLE;
+		pthread_cond_broadcast(&user_data->async_cond);
+	}
+	pthread_mutex_unlock(&user_data->async_mutex);
+	return NULL;
+}
+
+/*
+ * Allocate a second tile buffer and start the worker thread for
+ * send_buffer_async(). Only full buffer mode (u8g2_Setup_..._f) is supported.
+ * Call this after u8g2_SetGray4Buffer(), the second buffer has the size of
+ * the current tile buffer.
+ * policy is ASYNC_FLUSH_BLOCK or ASYNC_FLUSH_DROP. Returns 0 on success.
+ */
+int init_async_flush(u8g2_t *u8g2, uint8_t policy) {
+	user_data_t *user_data = u8g2_GetUserPtr(u8g2);
+	if (user_data->async_buf != NULL) {
+		user_data->async_policy = policy;
+		return 0;
+	}
+	if (u8g2_GetBufferTileHeight(u8g2) != u8x8_GetRows(u8g2_GetU8x8(u8g2))) {
+		fprintf(stderr, "init_async_flush(): full buffer mode required\n");
+		return -1;
+	}
+	user_data->async_buf_size = get_tile_buf_size(u8g2);
+	user_data->async_buf = (uint8_t*) malloc(user_data->async_buf_size);
+	if (user_data->async_buf == NULL) {
+		perror("init_async_flush()");
+		return -1;
+	}
+	user_data->async_orig_buf = u8g2_GetBufferPtr(u8g2);
+	user_data->async_frame = user_data->async_buf;
+	user_data->async_is_sent = 0;
+	user_data->async_state = ASYNC_FLUSH_IDLE;
+	user_data->async_policy = policy;
+	user_data->async_dropped = 0;
+	pthread_mutex_init(&user_data->async_mutex, NULL);
+	pthread_cond_init(&user_data->async_cond, NULL);
+	if (pthread_create(&user_data->async_thread, NULL, async_flush_thread,
+			u8g2) != 0) {
+		perror("init_async_flush()");
+		pthread_cond_destroy(&user_data->async_cond);
+		pthread_mutex_destroy(&user_data->async_mutex);
+		free(user_data->async_buf);
+		user_data->async_buf = NULL;
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Hand over the tile buffer to the worker thread and return without waiting
+ * for the bus transfer. The tile buffer is exchanged with the second buffer
+ * (u8g2_SetBufferPtr), which receives a copy of the frame, so drawing can
+ * continue on top of the previous content like with u8g2_SendBuffer().
+ * If the previous frame is still sent, ASYNC_FLUSH_BLOCK will wait for it and
+ * ASYNC_FLUSH_DROP will skip this frame and return 0. Returns 1 otherwise.
+ * Without init_async_flush() this is the same as u8g2_SendBuffer(). If the
+ * size of the tile buffer has changed since init_async_flush(), the frame is
+ * sent with u8g2_SendBuffer() after the previous frame.
+ * Other u8x8/u8g2 procedures, which access the display (u8g2_SetContrast,
+ * u8g2_SetPowerSave, ...), must not be called before wait_async_flush().
+ */
+uint8_t send_buffer_async(u8g2_t *u8g2) {
+	user_data_t *user_data = u8g2_GetUserPtr(u8g2);
+	uint8_t *buf;
+	if (user_data->async_buf == NULL) {
+		u8g2_SendBuffer(u8g2);
+		return 1;
+	}
+	pthread_mutex_lock(&user_data->async_mutex);
+	if (user_data->async_state != ASYNC_FLUSH_IDLE
+			&& user_data->async_policy == ASYNC_FLUSH_DROP) {
+		user_data->async_dropped++;
+		pthread_mutex_unlock(&user_data->async_mutex);
+		return 0;
+	}
+	while (user_data->async_state != ASYNC_FLUSH_IDLE) {
+		pthread_cond_wait(&user_data->async_cond, &user_data->async_mutex);
+	}
+	sync_async_flush(u8g2);
+	if (get_tile_buf_size(u8g2) != user_data->async_buf_size) {
+		pthread_mutex_unlock(&user_data->async_mutex);
+		u8g2_SendBuffer(u8g2);
+		return 1;
+	}
+	// async_frame is not used by the worker thread, use it for the next frame
+	buf = user_data->async_frame;
+	memcpy(buf, u8g2_GetBufferPtr(u8g2), user_data->async_buf_size);
+	user_data->async_frame = u8g2_GetBufferPtr(u8g2);
+	user_data->async_u8g2 = *u8g2;
+	user_data->async_u8g2.tile_buf_ptr = user_data->async_frame;
+#ifdef U8G2_WITH_SHADOW_BUFFER
+	// Updated by sync_async_flush() after the frame has been sent
+	u8g2->is_shadow_buf_invalid = 0;
+#endif
+	u8g2_SetBufferPtr(u8g2, buf);
+	user_data->async_state = ASYNC_FLUSH_BUSY;
+	pthread_cond_broadcast(&user_data->async_cond);
+	pthread_mutex_unlock(&user_data->async_mutex);
+	return 1;
+}
+
+/*
+ * Wait until the worker thread has sent the last frame.
+ */
+void wait_async_flush(u8g2_t *u8g2) {
+	user_data_t *user_data = u8g2_GetUserPtr(u8g2);
+	if (user_data->async_buf == NULL) {
+		return;
+	}
+	pthread_mutex_lock(&user_data->async_mutex);
+	while (user_data->async_state != ASYNC_FLUSH_IDLE) {
+		pthread_cond_wait(&user_data->async_cond, &user_data->async_mutex);
+	}
+	sync_async_flush(u8g2);
+	pthread_mutex_unlock(&user_data->async_mutex);
+}
+
+/*
+ * Wait for the last frame, stop the worker thread and free the second buffer.
+ * The current tile buffer is moved back to the buffer, which was used before
+ * init_async_flush().
+ */
+void done_async_flush(u8g2_t *u8g2) {
+	user_data_t *user_data = u8g2_GetUserPtr(u8g2);
+	if (user_data->async_buf == NULL) {
+		return;
+	}
+	wait_async_flush(u8g2);
+	pthread_mutex_lock(&user_data->async_mutex);
+	user_data->async_state = ASYNC_FLUSH_QUIT;
+	pthread_cond_broadcast(&user_data->async_cond);
+	pthread_mutex_unlock(&user_data->async_mutex);
+	pthread_join(user_data->async_thread, NULL);
+	pthread_cond_destroy(&user_data->async_cond);
+	pthread_mutex_destroy(&user_data->async_mutex);
+	if (u8g2_GetBufferPtr(u8g2) != user_data->async_orig_buf) {
+		memcpy(user_data->async_orig_buf, u8g2_GetBufferPtr(u8g2),
+				user_data->async_buf_size);
+		u8g2_SetBufferPtr(u8g2, user_data->async_orig_buf);
+	}
+	free(user_data->async_buf);
+	user_data->async_buf = NULL;
+	user_data->async_frame = NULL;
+}
+
+/*
+ * Worker thread of render_parallel(): Draw one band into its tile buffer.
+ */
+static void* render_band_thread(void *arg) {
+	render_band_t *band = (render_band_t*) arg;
+	u8g2_ClearBuffer(&band->u8g2);
+	band->draw(&band->u8g2, band->arg);
+	return NULL;
+}
+
+/*
+ * Draw the picture with up to thread_cnt threads and send it to the display.
+ * This replaces the picture loop:
+ *
+ *   u8g2_FirstPage(&u8g2);
+ *   do {
+ *     draw(&u8g2, arg);
+ *   } while (u8g2_NextPage(&u8g2));
+ *
+ * The display is divided into bands of tile rows. Each band is drawn by its
+ * own thread into its own tile buffer. draw() is called with a copy of the
+ * u8g2 structure, which has the page window (u8g2_SetBufferCurrTileRow) and
+ * the clip window of the band. Changes to the copy (font, draw color, ...)
+ * are not visible in the u8g2 structure after render_parallel().
+ * The glyph cache and the font index are not used by the threads. Each band
+ * gets its own polygon buffer (u8g2_SetPolygonBuffer) of the same size.
+ * The calling thread sends the bands in order as soon as they are finished.
+ * The flush rotation (u8g2_SetFlushRotation) and the recording of a display
+ * list (u8g2_BeginDisplayList) are not supported.
+ * Returns 0 on success.
+ */
+int render_parallel(u8g2_t *u8g2, void (*draw)(u8g2_t *u8g2, void *arg),
+		void *arg, uint8_t thread_cnt) {
+	uint8_t *tile_buf_ptr = u8g2_GetBufferPtr(u8g2);
+	uint8_t tile_buf_height = u8g2_GetBufferTileHeight(u8g2);
+	uint8_t tile_height = u8x8_GetRows(u8g2_GetU8x8(u8g2));
+	size_t band_size;
+	size_t pg_size = 0;
+	uint8_t band_rows;
+	uint8_t band_cnt;
+	uint8_t *buf;
+	uint8_t *pg_buf = NULL;
+	render_band_t *bands;
+	int i;
+
+#ifdef U8G2_WITH_FLUSH_ROTATION
+	if (u8g2->cb == &u8g2_cb_flush_rotation) {
+		fprintf(stderr, "render_parallel(): flush rotation is not supported\n");
+		return -1;
+	}
+#endif
+#ifdef U8G2_WITH_DISPLAY_LIST
+	if (u8g2_IsDisplayListRecording(u8g2)) {
+		fprintf(stderr, "render_parallel(): display list is recorded\n");
+		return -1;
+	}
+#endif
+	if (thread_cnt == 0) {
+		thread_cnt = 1;
+	}
+	band_rows = (tile_height + thread_cnt - 1) / thread_cnt;
+	band_cnt = (tile_height + band_rows - 1) / band_rows;
+	band_size = (size_t) u8x8_GetCols(u8g2_GetU8x8(u8g2)) * 8 * band_rows;
+#ifdef U8G2_WITH_GRAY4
+	if (u8g2->is_gray4_buffer) {
+		band_size *= 4;
+	}
+#endif
+#if defined(U8G2_WITH_INSTANCE_POLYGON) && defined(U8G2_WITH_POLYGON_EDGE_TABLE)
+	if (u8g2->pg.buf != NULL) {
+		pg_size = U8G2_POLYGON_BUFFER_SIZE(u8g2->pg.buf_max_cnt);
+		pg_buf = (uint8_t*) malloc(pg_size * band_cnt);
+	}
+#endif
+	buf = (uint8_t*) malloc(band_size * band_cnt);
+	bands = (render_band_t*) malloc(sizeof(render_band_t) * band_cnt);
+	if (buf == NULL || bands == NULL || (pg_size > 0 && pg_buf == NULL)) {
+		perror("render_parallel()");
+		free(buf);
+		free(bands);
+		free(pg_buf);
+		return -1;
+	}
+
+	for (i = 0; i < band_cnt; ++i) {
+		bands[i].u8g2 = *u8g2;
+		bands[i].u8g2.tile_buf_ptr = buf + band_size * i;
+		bands[i].u8g2.tile_buf_height = band_rows;
+#ifdef U8G2_WITH_FONT_INDEX
+		// The index would be modified by u8g2_SetFont() in all threads
+		bands[i].u8g2.font_index_ptr = NULL;
+		bands[i].u8g2.font_index_font = NULL;
+#endif
+#ifdef U8G2_WITH_GLYPH_CACHE
+		bands[i].u8g2.glyph_cache_ptr = NULL;
+#endif
+#if defined(U8G2_WITH_INSTANCE_POLYGON) && defined(U8G2_WITH_POLYGON_EDGE_TABLE)
+		// The polygon buffer is modified by u8g2_DrawPolygon()
+		if (pg_buf != NULL) {
+			u8g2_SetPolygonBuffer(&bands[i].u8g2, pg_buf + pg_size * i,
+					pg_size);
+		}
+#endif
+		u8g2_SetBufferCurrTileRow(&bands[i].u8g2, i * band_rows);
+		bands[i].draw = draw;
+		bands[i].arg = arg;
+		if (pthread_create(&bands[i].thread, NULL, render_band_thread,
+				bands + i) != 0) {
+			// Draw this band without a thread
+			render_band_thread(bands + i);
+			bands[i].thread = pthread_self();
+		}
+	}
+
+	// Send the bands in order, the remaining threads continue to draw
+	for (i = 0; i < band_cnt; ++i) {
+		if (!pthread_equal(bands[i].thread, pthread_self())) {
+			pthread_join(bands[i].thread, NULL);
+		}
+		u8g2->tile_buf_ptr = bands[i].u8g2.tile_buf_ptr;
+		u8g2->tile_buf_height = band_rows;
+		u8g2_SetBufferCurrTileRow(u8g2, i * band_rows);
+		u8g2_UpdateDisplay(u8g2);
+	}
+	u8x8_RefreshDisplay(u8g2_GetU8x8(u8g2));
+
+	// Restore the tile buffer of the display
+	u8g2->tile_buf_ptr = tile_buf_ptr;
+	u8g2->tile_buf_height = tile_buf_height;
+	u8g2_SetBufferCurrTileRow(u8g2, 0);
+	free(bands);
+	free(buf);
+	free(pg_buf);
+	return 0;
+}
@@ -12,9 +12,28 @@ extern "C" {
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+#include <pthread.h>
 
 #define MAX_I2C_HANDLES 8
 #define MAX_SPI_HANDLES 256
+// Max number of queued transfers for one SPI_IOC_MESSAGE
+#define MAX_SPI_TRANSFERS 32
+// Max number of bytes for one SPI_IOC_MESSAGE, default bufsiz of spidev
+#define MAX_SPI_MESSAGE_LEN 4096
+
+// Policy of send_buffer_async(), if the previous frame is still sent
+// Wait until the previous frame has been sent
+#define ASYNC_FLUSH_BLOCK 0
+// Do not send the new frame
+#define ASYNC_FLUSH_DROP 1
+
+// State of the async flush worker thread
+#define ASYNC_FLUSH_IDLE 0
+#define ASYNC_FLUSH_BUSY 1
+#define ASYNC_FLUSH_QUIT 2
 
 /*
  * User data passed in user_ptr of u8x8_struct.
@@ -38,10 +57,62 @@ struct user_data_struct {
 	uint32_t max_speed;
 	// Internal buffer
 	uint8_t *int_buf;
+	// Size of the internal buffer
+	size_t int_buf_size;
+	// Queued SPI transfers, sent with one SPI_IOC_MESSAGE
+	struct spi_ioc_transfer spi_transfers[MAX_SPI_TRANSFERS];
+	// Number of queued SPI transfers
+	uint8_t spi_cnt;
+	// Number of bytes in all queued SPI transfers
+	uint16_t spi_len;
+	// Current level of the DC line, 255 if unknown
+	uint8_t spi_dc;
+	// Number of bytes in spi_buf
+	uint16_t spi_buf_len;
+	// Copy of all bytes, which are not part of the internal buffer
+	uint8_t spi_buf[MAX_SPI_MESSAGE_LEN];
+	// Second tile buffer for send_buffer_async(), NULL if not used
+	uint8_t *async_buf;
+	// Size of async_buf, same as the tile buffer of the display (mono or gray4)
+	size_t async_buf_size;
+	// Tile buffer of the display when init_async_flush() was called
+	uint8_t *async_orig_buf;
+	// Tile buffer, which is sent by the worker thread
+	uint8_t *async_frame;
+	// Copy of the u8g2 structure for the worker thread, tile_buf_ptr is async_frame
+	u8g2_t async_u8g2;
+	// 1 if async_u8g2 has sent a frame, which is not yet copied back by the caller
+	uint8_t async_is_sent;
+	// Worker thread of send_buffer_async()
+	pthread_t async_thread;
+	pthread_mutex_t async_mutex;
+	// Signals changes of async_state
+	pthread_cond_t async_cond;
+	// ASYNC_FLUSH_IDLE, ASYNC_FLUSH_BUSY or ASYNC_FLUSH_QUIT
+	uint8_t async_state;
+	// ASYNC_FLUSH_BLOCK or ASYNC_FLUSH_DROP
+	uint8_t async_policy;
+	// Number of frames, which were not sent because of ASYNC_FLUSH_DROP
+	unsigned long async_dropped;
 };
 
 typedef struct user_data_struct user_data_t;
 
+/*
+ * One band of tile rows for render_parallel().
+ */
+struct render_band_struct {
+	// Copy of the u8g2 structure with its own tile buffer
+	u8g2_t u8g2;
+	// Draw procedure and argument of render_parallel()
+	void (*draw)(u8g2_t *u8g2, void *arg);
+	void *arg;
+	// Worker thread, which renders this band
+	pthread_t thread;
+};
+
+typedef struct render_band_struct render_band_t;
+
 void sleep_ms(unsigned long milliseconds);
 void sleep_us(unsigned long microseconds);
 void sleep_ns(unsigned long nanoseconds);
@@ -62,6 +133,13 @@ void init_i2c(u8x8_t *u8x8);
 void done_i2c();
 void init_spi(u8x8_t *u8x8);
 void done_spi();
+void flush_spi(u8x8_t *u8x8);
+int init_async_flush(u8g2_t *u8g2, uint8_t policy);
+uint8_t send_buffer_async(u8g2_t *u8g2);
+void wait_async_flush(u8g2_t *u8g2);
+void done_async_flush(u8g2_t *u8g2);
+int render_parallel(u8g2_t *u8g2, void (*draw)(u8g2_t *u8g2, void *arg),
+		void *arg, uint8_t thread_cnt);
 uint8_t u8x8_arm_linux_gpio_and_delay(u8x8_t *u8x8, uint8_t msg,
 		uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_byte_arm_linux_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
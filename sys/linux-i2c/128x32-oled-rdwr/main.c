@@ -0,0 +1,42 @@
+#include <linux-i2c.h>
+#include <u8g2.h>
+#include <stdio.h>
+
+#define SSD1306_ADDR  0x3c
+
+u8g2_t u8g2;
+
+int main (void)
+{
+	uint8_t tile_buf_height;
+	uint8_t *buf;
+
+	/*
+	  Same as u8g2_Setup_ssd1306_i2c_128x32_univision_f(), but with the bulk
+	  cad procedure: Each tile row is sent with one I2C_RDWR ioctl.
+	*/
+	u8g2_SetupDisplay(&u8g2, u8x8_d_ssd1306_128x32_univision, u8x8_cad_ssd13xx_bulk_i2c, u8x8_byte_linux_i2c_rdwr, u8x8_linux_i2c_delay);
+	buf = u8g2_m_16_4_f(&tile_buf_height);
+	u8g2_SetupBuffer(&u8g2, buf, tile_buf_height, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+
+	/* u8x8_byte_linux_i2c_rdwr expects the 8 bit address */
+	u8g2_SetI2CAddress(&u8g2, SSD1306_ADDR*2);
+
+	u8g2_InitDisplay(&u8g2);
+
+	u8g2_SetPowerSave(&u8g2, 0);
+
+	u8g2_ClearBuffer(&u8g2);
+
+	u8g2_SetFont(&u8g2, u8g2_font_smart_patrol_nbp_tr);
+
+	u8g2_SetFontRefHeightText(&u8g2);
+
+	u8g2_SetFontPosTop(&u8g2);
+
+	u8g2_DrawStr(&u8g2, 0, 0, "u8g2 Linux I2C_RDWR");
+
+	u8g2_SendBuffer(&u8g2);
+
+}
+
@@ -1,10 +1,12 @@
 #include <errno.h>
 #include <fcntl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <linux/i2c-dev.h>
 #include <i2c/smbus.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
@@ -56,6 +58,8 @@ u8x8_byte_linux_i2c(u8x8_t *u8x8,
 			return(errno);
 		}
 		fprintf(stderr, "set i2c addr %0x\n", addr);
+		/* smbus block write: one command byte plus up to 31 bytes */
+		u8x8_SetI2CMaxTransfer(u8x8, BUFSIZ_I2C-1);
 		break;
 	case U8X8_MSG_BYTE_SET_DC:
 		/* ignored for i2c */
@@ -82,6 +86,99 @@ u8x8_byte_linux_i2c(u8x8_t *u8x8,
 }
 
 
+/*
+  Alternative byte procedure: Collect all bytes of a transfer and send them
+  with one I2C_RDWR ioctl. Unlike i2c_smbus_write_i2c_block_data() there is
+  no 32 byte limit, so the cad procedures can send 255 data bytes per
+  transfer. Use this together with u8x8_cad_ssd13xx_bulk_i2c to send a
+  complete tile row with one single system call:
+
+	u8g2_SetupDisplay(&u8g2, u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_bulk_i2c, u8x8_byte_linux_i2c_rdwr, u8x8_linux_i2c_delay);
+	buf = u8g2_m_16_8_f(&tile_buf_height);
+	u8g2_SetupBuffer(&u8g2, buf, tile_buf_height, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+
+  The I2C address is taken from u8x8 (8 bit format, default 0x78).
+  See ../128x32-oled-rdwr/main.c for a complete example.
+*/
+
+#define RDWR_MAX_LEN 8192	/* max length of one i2c message, see i2c-dev.c */
+
+static uint8_t *rdwr_data = NULL;
+static uint16_t rdwr_size = 0;
+static uint16_t rdwr_len = 0;
+static uint8_t rdwr_is_overflow = 0;
+
+uint8_t
+u8x8_byte_linux_i2c_rdwr(u8x8_t *u8x8,
+		    uint8_t msg,
+		    uint8_t arg_int,
+		    void *arg_ptr)
+{
+	struct i2c_msg i2c_msg;
+	struct i2c_rdwr_ioctl_data msgset;
+	uint8_t *p;
+	
+	switch(msg){
+	case U8X8_MSG_BYTE_SEND:
+		if (rdwr_len + arg_int > rdwr_size) {
+			if (rdwr_len + arg_int > RDWR_MAX_LEN) {
+				rdwr_is_overflow = 1;
+				break;
+			}
+			p = realloc(rdwr_data, rdwr_len + arg_int + 256);
+			if (p == NULL) {
+				rdwr_is_overflow = 1;
+				break;
+			}
+			rdwr_data = p;
+			rdwr_size = rdwr_len + arg_int + 256;
+		}
+		memcpy(rdwr_data + rdwr_len, arg_ptr, arg_int);
+		rdwr_len += arg_int;
+		break;
+	case U8X8_MSG_BYTE_INIT:
+		snprintf(filename, 19, "/dev/i2c-%d", adapter_nr);
+		file = open(filename, O_RDWR);
+		if (file < 0) {
+			fprintf(stderr, "can't open i2c\n");
+			return(errno); 
+		}
+		/* the length of a transfer is only limited by the arg_int of the cad procedures */
+		u8x8_SetI2CMaxTransfer(u8x8, 255);
+		break;
+	case U8X8_MSG_BYTE_SET_DC:
+		/* ignored for i2c */
+		break;
+	case U8X8_MSG_BYTE_START_TRANSFER:
+		rdwr_len = 0;
+		rdwr_is_overflow = 0;
+		break;
+	case U8X8_MSG_BYTE_END_TRANSFER:
+		if (rdwr_is_overflow != 0) {
+			fprintf(stderr, "i2c transfer too long\n");
+			return 0;
+		}
+		if (rdwr_len == 0)
+			break;
+		i2c_msg.addr = u8x8_GetI2CAddress(u8x8) >> 1;
+		i2c_msg.flags = 0;
+		i2c_msg.len = rdwr_len;
+		i2c_msg.buf = rdwr_data;
+		msgset.msgs = &i2c_msg;
+		msgset.nmsgs = 1;
+		if (ioctl(file, I2C_RDWR, &msgset) < 0) {
+			fprintf(stderr, "can't write %d bytes: %s\n", rdwr_len, strerror(errno));
+			return(errno); 
+		}
+		break;
+	default:
+		fprintf(stderr, "unknown msg type %d\n", msg);
+		return 0;
+	}
+	return 1;
+}
+
+
 uint8_t
 u8x8_linux_i2c_delay(u8x8_t *u8x8,
 		     uint8_t msg,
@@ -0,0 +1,315 @@
+/*
+
+  bitmap.c
+
+  Bitmap test: The bitmap procedures of u8g2_bitmap.c are compared with the
+  pixel by pixel procedures of u8g2 v2.34 (bitmap_old_... below).
+
+  make test
+
+  will build and run the test. Each random scene is drawn with the picture
+  loop into a frame, once with the new and once with the old procedures.
+  Both frames must be identical. The scenes use all rotations, the flush
+  rotation, page and full buffer mode, both buffer layouts, clip windows,
+  draw colors, solid and transparent bitmap mode and positions outside of
+  the display.
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCENES 8000
+#define BITMAPS_PER_SCENE 4
+
+/*===========================================*/
+/* bitmap procedures of u8g2 v2.34 */
+
+static void bitmap_old_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b)
+{
+  uint8_t mask;
+  uint8_t color = u8g2->draw_color;
+  uint8_t ncolor = (color == 0 ? 1 : 0);
+
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 )
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+
+  mask = 128;
+  while(len > 0)
+  {
+    if ( *b & mask ) {
+      u8g2->draw_color = color;
+      u8g2_DrawHVLine(u8g2, x, y, 1, 0);
+    } else if ( u8g2->bitmap_transparency == 0 ) {
+      u8g2->draw_color = ncolor;
+      u8g2_DrawHVLine(u8g2, x, y, 1, 0);
+    }
+
+    x++;
+    mask >>= 1;
+    if ( mask == 0 )
+    {
+      mask = 128;
+      b++;
+    }
+    len--;
+  }
+  u8g2->draw_color = color;
+}
+
+static void bitmap_old_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_uint_t w;
+  w = cnt;
+  w *= 8;
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 )
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+
+  while( h > 0 )
+  {
+    bitmap_old_DrawHorizontalBitmap(u8g2, x, y, w, bitmap);
+    bitmap += cnt;
+    y++;
+    h--;
+  }
+}
+
+/* u8g2_DrawHXBMP() was identical to u8g2_DrawHXBM() on systems with u8x8_pgm_read(adr) == *(adr) */
+static void bitmap_old_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b)
+{
+  uint8_t mask;
+  uint8_t color = u8g2->draw_color;
+  uint8_t ncolor = (color == 0 ? 1 : 0);
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 )
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+
+  mask = 1;
+  while(len > 0) {
+    if ( *b & mask ) {
+      u8g2->draw_color = color;
+      u8g2_DrawHVLine(u8g2, x, y, 1, 0);
+    } else if ( u8g2->bitmap_transparency == 0 ) {
+      u8g2->draw_color = ncolor;
+      u8g2_DrawHVLine(u8g2, x, y, 1, 0);
+    }
+    x++;
+    mask <<= 1;
+    if ( mask == 0 )
+    {
+      mask = 1;
+      b++;
+    }
+    len--;
+  }
+  u8g2->draw_color = color;
+}
+
+static void bitmap_old_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_uint_t blen;
+  blen = w;
+  blen += 7;
+  blen >>= 3;
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 )
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+
+  while( h > 0 )
+  {
+    bitmap_old_DrawHXBM(u8g2, x, y, w, bitmap);
+    bitmap += blen;
+    y++;
+    h--;
+  }
+}
+
+/*===========================================*/
+/* scenes */
+
+/* not declared in u8g2.h */
+void u8g2_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b);
+void u8g2_DrawHXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b);
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+/* the old and the new procedures */
+struct bitmap_procedures
+{
+  void (*draw_xbm)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+  void (*draw_xbmp)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+  void (*draw_hxbm)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b);
+  void (*draw_hxbmp)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b);
+  void (*draw_bitmap)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt, u8g2_uint_t h, const uint8_t *bitmap);
+  void (*draw_horizontal_bitmap)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b);
+};
+
+static const struct bitmap_procedures bitmap_new =
+{
+  u8g2_DrawXBM, u8g2_DrawXBMP, u8g2_DrawHXBM, u8g2_DrawHXBMP, u8g2_DrawBitmap, u8g2_DrawHorizontalBitmap
+};
+
+static const struct bitmap_procedures bitmap_old =
+{
+  bitmap_old_DrawXBM, bitmap_old_DrawXBM, bitmap_old_DrawHXBM, bitmap_old_DrawHXBM, bitmap_old_DrawBitmap, bitmap_old_DrawHorizontalBitmap
+};
+
+static const setup_cb bitmap_setup_list[] =
+{
+  u8g2_Setup_ssd1306_128x64_noname_1,
+  u8g2_Setup_ssd1306_128x64_noname_2,
+  u8g2_Setup_ssd1306_128x64_noname_f,
+  u8g2_Setup_st7920_s_128x64_1,		/* horizontal_right_lsb */
+  u8g2_Setup_st7920_s_128x64_f,
+  u8g2_Setup_sed1520_122x32_1,		/* width is not a multiple of 8 */
+};
+
+static const u8g2_cb_t *bitmap_rotation_list[] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3, U8G2_MIRROR };
+
+#define CNT(a) (sizeof(a)/sizeof(*(a)))
+
+struct bitmap_scene
+{
+  setup_cb setup;
+  const u8g2_cb_t *rotation;
+  uint8_t is_flush_rotation;	/* u8g2_SetFlushRotation() for U8G2_R1 and U8G2_R3 */
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+  uint8_t procedure[BITMAPS_PER_SCENE];
+  uint8_t color[BITMAPS_PER_SCENE];
+  uint8_t is_transparent[BITMAPS_PER_SCENE];
+  u8g2_uint_t x[BITMAPS_PER_SCENE], y[BITMAPS_PER_SCENE], w[BITMAPS_PER_SCENE], h[BITMAPS_PER_SCENE];
+  uint8_t bitmap[BITMAPS_PER_SCENE][12*80];
+};
+
+static uint8_t frame_new[1024];
+static uint8_t frame_old[1024];
+
+static uint8_t bitmap_dummy_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* a position around the display or any value of u8g2_uint_t */
+static u8g2_uint_t bitmap_rand_pos(u8g2_uint_t size)
+{
+  if ( rand() % 16 == 0 )
+    return (u8g2_uint_t)rand();
+  return (u8g2_uint_t)(rand() % (size + 80) - 60);
+}
+
+static void bitmap_setup(u8g2_t *u8g2, const struct bitmap_scene *scene)
+{
+  scene->setup(u8g2, scene->rotation, bitmap_dummy_cb, bitmap_dummy_cb);
+  if ( scene->is_flush_rotation )
+    u8g2_SetFlushRotation(u8g2, scene->rotation);
+}
+
+static void bitmap_rand_scene(struct bitmap_scene *scene)
+{
+  static u8g2_t u8g2;
+  u8g2_uint_t w, h;
+  size_t j;
+  int i;
+
+  scene->setup = bitmap_setup_list[rand() % CNT(bitmap_setup_list)];
+  scene->rotation = bitmap_rotation_list[rand() % CNT(bitmap_rotation_list)];
+  scene->is_flush_rotation = rand() % 2;
+  bitmap_setup(&u8g2, scene);
+  w = u8g2_GetDisplayWidth(&u8g2);
+  h = u8g2_GetDisplayHeight(&u8g2);
+
+  /* clip windows must not be empty */
+  scene->is_clip = rand() % 2;
+  scene->clip_x0 = rand() % w;
+  scene->clip_x1 = scene->clip_x0 + 1 + rand() % (w - scene->clip_x0);
+  scene->clip_y0 = rand() % h;
+  scene->clip_y1 = scene->clip_y0 + 1 + rand() % (h - scene->clip_y0);
+
+  for( i = 0; i < BITMAPS_PER_SCENE; i++ )
+  {
+    scene->procedure[i] = rand() % 6;
+    scene->color[i] = rand() % 3;
+    scene->is_transparent[i] = rand() % 2;
+    scene->x[i] = bitmap_rand_pos(w);
+    scene->y[i] = bitmap_rand_pos(h);
+    scene->w[i] = 1 + rand() % 80;	/* number of bytes for u8g2_DrawBitmap() */
+    scene->h[i] = 1 + rand() % 80;
+    if ( scene->procedure[i] == 4 )
+      scene->w[i] = 1 + rand() % 12;
+    for( j = 0; j < sizeof(scene->bitmap[i]); j++ )
+      scene->bitmap[i][j] = rand();
+  }
+}
+
+/* draw the scene with the picture loop and collect the pages in frame */
+static void bitmap_draw_scene(const struct bitmap_scene *scene, const struct bitmap_procedures *p, uint8_t *frame)
+{
+  static u8g2_t u8g2;
+  size_t row_size, page_size, frame_size;
+  int i;
+
+  bitmap_setup(&u8g2, scene);
+  row_size = (size_t)u8g2_GetU8x8(&u8g2)->display_info->tile_width*8;
+  frame_size = row_size*u8g2_GetU8x8(&u8g2)->display_info->tile_height;
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    u8g2_SetDrawColor(&u8g2, 1);
+    u8g2_DrawBox(&u8g2, 10, 5, 40, 30);
+    if ( scene->is_clip )
+      u8g2_SetClipWindow(&u8g2, scene->clip_x0, scene->clip_y0, scene->clip_x1, scene->clip_y1);
+    for( i = 0; i < BITMAPS_PER_SCENE; i++ )
+    {
+      u8g2_SetDrawColor(&u8g2, scene->color[i]);
+      u8g2_SetBitmapMode(&u8g2, scene->is_transparent[i]);
+      switch(scene->procedure[i])
+      {
+	case 0: p->draw_xbm(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i], scene->bitmap[i]); break;
+	case 1: p->draw_xbmp(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i], scene->bitmap[i]); break;
+	case 2: p->draw_hxbm(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->bitmap[i]); break;
+	case 3: p->draw_hxbmp(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->bitmap[i]); break;
+	case 4: p->draw_bitmap(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i], scene->bitmap[i]); break;
+	default: p->draw_horizontal_bitmap(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->bitmap[i]); break;
+      }
+    }
+    u8g2_SetMaxClipWindow(&u8g2);
+    /* the flush rotation has only one page with the rotated size */
+    page_size = (size_t)u8g2.pixel_buf_width*u8g2.pixel_buf_height/8;
+    if ( page_size > frame_size - row_size*u8g2.tile_curr_row )
+      page_size = frame_size - row_size*u8g2.tile_curr_row;
+    memcpy(frame + row_size*u8g2.tile_curr_row, u8g2.tile_buf_ptr, page_size);
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+int main(void)
+{
+  static struct bitmap_scene scene;
+  int n, i;
+
+  for( n = 0; n < SCENES; n++ )
+  {
+    bitmap_rand_scene(&scene);
+    bitmap_draw_scene(&scene, &bitmap_new, frame_new);
+    bitmap_draw_scene(&scene, &bitmap_old, frame_old);
+    if ( memcmp(frame_new, frame_old, sizeof(frame_new)) != 0 )
+    {
+      printf("scene %d differs, flush rotation %d, clip %d: %d %d %d %d\n", n, scene.is_flush_rotation,
+	scene.is_clip, scene.clip_x0, scene.clip_y0, scene.clip_x1, scene.clip_y1);
+      for( i = 0; i < BITMAPS_PER_SCENE; i++ )
+	printf("  procedure %d, color %d, transparent %d: %d %d %d %d\n", scene.procedure[i], scene.color[i],
+	  scene.is_transparent[i], scene.x[i], scene.y[i], scene.w[i], scene.h[i]);
+      return 1;
+    }
+  }
+  printf("%d scenes ok\n", SCENES);
+  return 0;
+}
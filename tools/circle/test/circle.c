@@ -0,0 +1,365 @@
+/*
+
+  circle.c
+
+  Circle test: The circle, disc, ellipse and box procedures of u8g2 are
+  compared with the procedures of u8g2 v2.34 (circle_old.c).
+
+  make test
+
+  will build and run the test. Each random scene is drawn with the picture
+  loop into a frame, once with the new and once with the old procedures.
+  Both frames must be identical. The scenes use all rotations, page and full
+  buffer mode, both buffer layouts, clip windows, draw colors, all quadrant
+  options and positions outside of the display.
+
+  Exception: The old filled ellipse skips a column for flat ellipses, which
+  leaves a one pixel hole in the center row. The new procedure closes these
+  rows, so the reference for draw color 0 and 1 is the old procedure with
+  closed rows (circle_closed_filled_ellipse below). Draw color 2 still uses
+  the old procedure.
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCENES 8000
+#define SHAPES_PER_SCENE 4
+
+/*===========================================*/
+/* circle_old.c */
+
+void circle_old_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
+void circle_old_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
+void circle_old_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+void circle_old_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+void circle_old_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void circle_old_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+void circle_old_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+
+/*===========================================*/
+/* filled ellipse of u8g2 v2.34 with closed rows */
+
+#define MAX_RX 120
+
+/*
+  Same loops as the old filled ellipse, but the height of each column
+  is the maximum height of all columns to the right. This closes the rows
+  at skipped columns, all other columns have the old height.
+*/
+static void circle_closed_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
+{
+  long height[MAX_RX+1];
+  long max_height;
+  u8g2_uint_t x, y;
+  u8g2_long_t xchg, ychg;
+  u8g2_long_t err;
+  u8g2_long_t rxrx2;
+  u8g2_long_t ryry2;
+  u8g2_long_t stopx, stopy;
+  long i;
+
+  if ( u8g2->draw_color == 2 )
+  {
+    circle_old_DrawFilledEllipse(u8g2, x0, y0, rx, ry, option);
+    return;
+  }
+
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x0-rx, y0-ry, x0+rx+1, y0+ry+1) == 0 )
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+
+  for( i = 0; i <= rx; i++ )
+    height[i] = -1;
+
+  rxrx2 = rx;
+  rxrx2 *= rx;
+  rxrx2 *= 2;
+  ryry2 = ry;
+  ryry2 *= ry;
+  ryry2 *= 2;
+  x = rx;
+  y = 0;
+  xchg = 1;
+  xchg -= rx;
+  xchg -= rx;
+  xchg *= ry;
+  xchg *= ry;
+  ychg = rx;
+  ychg *= rx;
+  err = 0;
+  stopx = ryry2;
+  stopx *= rx;
+  stopy = 0;
+  while( stopx >= stopy )
+  {
+    if ( height[x] < y )
+      height[x] = y;
+    y++;
+    stopy += rxrx2;
+    err += ychg;
+    ychg += rxrx2;
+    if ( 2*err+xchg > 0 )
+    {
+      x--;
+      stopx -= ryry2;
+      err += xchg;
+      xchg += ryry2;
+    }
+  }
+
+  x = 0;
+  y = ry;
+  xchg = ry;
+  xchg *= ry;
+  ychg = 1;
+  ychg -= ry;
+  ychg -= ry;
+  ychg *= rx;
+  ychg *= rx;
+  err = 0;
+  stopx = 0;
+  stopy = rxrx2;
+  stopy *= ry;
+  while( stopx <= stopy )
+  {
+    if ( height[x] < y )
+      height[x] = y;
+    x++;
+    stopx += ryry2;
+    err += xchg;
+    xchg += ryry2;
+    if ( 2*err+ychg > 0 )
+    {
+      y--;
+      stopy -= rxrx2;
+      err += ychg;
+      ychg += rxrx2;
+    }
+  }
+
+  max_height = -1;
+  for( i = rx; i >= 0; i-- )
+  {
+    if ( max_height < height[i] )
+      max_height = height[i];
+    if ( max_height < 0 )
+      continue;
+    x = i;
+    y = max_height;
+    if ( option & U8G2_DRAW_UPPER_RIGHT )
+      u8g2_DrawVLine(u8g2, x0+x, y0-y, y+1);
+    if ( option & U8G2_DRAW_UPPER_LEFT )
+      u8g2_DrawVLine(u8g2, x0-x, y0-y, y+1);
+    if ( option & U8G2_DRAW_LOWER_RIGHT )
+      u8g2_DrawVLine(u8g2, x0+x, y0, y+1);
+    if ( option & U8G2_DRAW_LOWER_LEFT )
+      u8g2_DrawVLine(u8g2, x0-x, y0, y+1);
+  }
+}
+
+/*===========================================*/
+/* scenes */
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+/* the old and the new procedures */
+struct circle_procedures
+{
+  void (*draw_circle)(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
+  void (*draw_disc)(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option);
+  void (*draw_ellipse)(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+  void (*draw_filled_ellipse)(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option);
+  void (*draw_box)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+  void (*draw_rbox)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+  void (*draw_rframe)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, u8g2_uint_t r);
+};
+
+static const struct circle_procedures circle_new =
+{
+  u8g2_DrawCircle, u8g2_DrawDisc, u8g2_DrawEllipse, u8g2_DrawFilledEllipse, u8g2_DrawBox, u8g2_DrawRBox, u8g2_DrawRFrame
+};
+
+static const struct circle_procedures circle_old =
+{
+  circle_old_DrawCircle, circle_old_DrawDisc, circle_old_DrawEllipse, circle_closed_filled_ellipse, circle_old_DrawBox, circle_old_DrawRBox, circle_old_DrawRFrame
+};
+
+/* without closed rows: only used to count the scenes, which depend on the closed rows */
+static const struct circle_procedures circle_old_open =
+{
+  circle_old_DrawCircle, circle_old_DrawDisc, circle_old_DrawEllipse, circle_old_DrawFilledEllipse, circle_old_DrawBox, circle_old_DrawRBox, circle_old_DrawRFrame
+};
+
+static const setup_cb circle_setup_list[] =
+{
+  u8g2_Setup_ssd1306_128x64_noname_1,
+  u8g2_Setup_ssd1306_128x64_noname_2,
+  u8g2_Setup_ssd1306_128x64_noname_f,
+  u8g2_Setup_st7920_s_128x64_1,		/* horizontal_right_lsb */
+  u8g2_Setup_st7920_s_128x64_f,
+  u8g2_Setup_sed1520_122x32_1,		/* width is not a multiple of 8 */
+};
+
+static const u8g2_cb_t *circle_rotation_list[] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3, U8G2_MIRROR };
+
+#define CNT(a) (sizeof(a)/sizeof(*(a)))
+
+struct circle_scene
+{
+  setup_cb setup;
+  const u8g2_cb_t *rotation;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+  uint8_t procedure[SHAPES_PER_SCENE];
+  uint8_t color[SHAPES_PER_SCENE];
+  uint8_t option[SHAPES_PER_SCENE];
+  u8g2_uint_t x[SHAPES_PER_SCENE], y[SHAPES_PER_SCENE], w[SHAPES_PER_SCENE], h[SHAPES_PER_SCENE], r[SHAPES_PER_SCENE];
+};
+
+static uint8_t frame_new[1024];
+static uint8_t frame_old[1024];
+
+static uint8_t circle_dummy_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* a position around the display or any value of u8g2_uint_t */
+static u8g2_uint_t circle_rand_pos(u8g2_uint_t size)
+{
+  if ( rand() % 16 == 0 )
+    return (u8g2_uint_t)rand();
+  return (u8g2_uint_t)(rand() % (size + 80) - 40);
+}
+
+static void circle_rand_scene(struct circle_scene *scene)
+{
+  static u8g2_t u8g2;
+  u8g2_uint_t w, h, m;
+  int i;
+
+  scene->setup = circle_setup_list[rand() % CNT(circle_setup_list)];
+  scene->rotation = circle_rotation_list[rand() % CNT(circle_rotation_list)];
+  scene->setup(&u8g2, scene->rotation, circle_dummy_cb, circle_dummy_cb);
+  w = u8g2_GetDisplayWidth(&u8g2);
+  h = u8g2_GetDisplayHeight(&u8g2);
+
+  /* clip windows must not be empty */
+  scene->is_clip = rand() % 2;
+  scene->clip_x0 = rand() % w;
+  scene->clip_x1 = scene->clip_x0 + 1 + rand() % (w - scene->clip_x0);
+  scene->clip_y0 = rand() % h;
+  scene->clip_y1 = scene->clip_y0 + 1 + rand() % (h - scene->clip_y0);
+
+  for( i = 0; i < SHAPES_PER_SCENE; i++ )
+  {
+    scene->procedure[i] = rand() % 7;
+    scene->color[i] = rand() % 3;
+    scene->option[i] = rand() % 2 ? U8G2_DRAW_ALL : rand() % 16;
+    scene->x[i] = circle_rand_pos(w);
+    scene->y[i] = circle_rand_pos(h);
+    /* radius (rx, ry) or size of the box */
+    scene->w[i] = rand() % (MAX_RX+1);
+    scene->h[i] = rand() % 50;
+    /* flat ellipses */
+    if ( rand() % 4 == 0 )
+      scene->h[i] = rand() % 4;
+    if ( rand() % 4 == 0 )
+      scene->w[i] = rand() % 4;
+    /* the ellipse loops do not terminate for rx = 0 or ry = 0 */
+    if ( scene->procedure[i] == 2 || scene->procedure[i] == 3 )
+    {
+      if ( scene->w[i] == 0 )
+	scene->w[i] = 1;
+      if ( scene->h[i] == 0 )
+	scene->h[i] = 1;
+    }
+    if ( scene->procedure[i] >= 4 )
+    {
+      /* boxes do not work for w = 0 or h = 0 */
+      scene->w[i]++;
+      scene->h[i]++;
+      m = scene->w[i] < scene->h[i] ? scene->w[i] : scene->h[i];
+      scene->r[i] = rand() % ((m+1)/2);
+    }
+  }
+}
+
+/* draw the scene with the picture loop and collect the pages in frame */
+static void circle_draw_scene(const struct circle_scene *scene, const struct circle_procedures *p, uint8_t *frame)
+{
+  static u8g2_t u8g2;
+  size_t row_size, page_size, frame_size;
+  int i;
+
+  /* smaller displays do not cover the complete frame */
+  memset(frame, 0, sizeof(frame_new));
+  scene->setup(&u8g2, scene->rotation, circle_dummy_cb, circle_dummy_cb);
+  row_size = (size_t)u8g2_GetU8x8(&u8g2)->display_info->tile_width*8;
+  frame_size = row_size*u8g2_GetU8x8(&u8g2)->display_info->tile_height;
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    u8g2_SetDrawColor(&u8g2, 1);
+    u8g2_DrawBox(&u8g2, 10, 5, 40, 30);
+    if ( scene->is_clip )
+      u8g2_SetClipWindow(&u8g2, scene->clip_x0, scene->clip_y0, scene->clip_x1, scene->clip_y1);
+    for( i = 0; i < SHAPES_PER_SCENE; i++ )
+    {
+      u8g2_SetDrawColor(&u8g2, scene->color[i]);
+      switch(scene->procedure[i])
+      {
+	case 0: p->draw_circle(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->option[i]); break;
+	case 1: p->draw_disc(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->option[i]); break;
+	case 2: p->draw_ellipse(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i], scene->option[i]); break;
+	case 3: p->draw_filled_ellipse(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i], scene->option[i]); break;
+	case 4: p->draw_box(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i]); break;
+	case 5: p->draw_rbox(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i], scene->r[i]); break;
+	default: p->draw_rframe(&u8g2, scene->x[i], scene->y[i], scene->w[i], scene->h[i], scene->r[i]); break;
+      }
+    }
+    u8g2_SetMaxClipWindow(&u8g2);
+    page_size = row_size*u8g2.tile_buf_height;
+    if ( page_size > frame_size - row_size*u8g2.tile_curr_row )
+      page_size = frame_size - row_size*u8g2.tile_curr_row;
+    memcpy(frame + row_size*u8g2.tile_curr_row, u8g2.tile_buf_ptr, page_size);
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+int main(void)
+{
+  static struct circle_scene scene;
+  int n, i;
+  int closed = 0;
+
+  for( n = 0; n < SCENES; n++ )
+  {
+    circle_rand_scene(&scene);
+    circle_draw_scene(&scene, &circle_new, frame_new);
+    circle_draw_scene(&scene, &circle_old, frame_old);
+    if ( memcmp(frame_new, frame_old, sizeof(frame_new)) != 0 )
+    {
+      printf("scene %d differs, clip %d: %d %d %d %d\n", n, scene.is_clip, scene.clip_x0, scene.clip_y0, scene.clip_x1, scene.clip_y1);
+      for( i = 0; i < SHAPES_PER_SCENE; i++ )
+	printf("  procedure %d, color %d, option %d: %d %d %d %d %d\n", scene.procedure[i], scene.color[i],
+	  scene.option[i], scene.x[i], scene.y[i], scene.w[i], scene.h[i], scene.r[i]);
+      return 1;
+    }
+    circle_draw_scene(&scene, &circle_old_open, frame_old);
+    if ( memcmp(frame_new, frame_old, sizeof(frame_new)) != 0 )
+      closed++;
+  }
+  /* the scenes must also contain filled ellipses with holes in the old procedure */
+  if ( closed == 0 )
+  {
+    printf("no scene with closed rows\n");
+    return 1;
+  }
+  printf("%d scenes ok (%d with closed rows)\n", SCENES, closed);
+  return 0;
+}
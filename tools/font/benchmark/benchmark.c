@@ -0,0 +1,270 @@
+/*
+
+  benchmark.c
+
+  Glyph decoder benchmark: Decode all glyphs of all fonts, which are
+  given on the command line. The fonts are read from the C source
+  files (tools/font/build/single_font_files).
+
+  make bench
+
+  will build and run the benchmark. The checksums of the buffer and of
+  the bit stream must not change with modifications of the decoder.
+
+  bits:			read the bit stream of the glyph only
+  decode:		decode the glyph without access to the buffer
+  decode and draw:	decode and draw the glyph into the buffer
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define REPEAT 4
+#define MAX_FONT_SIZE 400000
+#define MAX_GLYPHS 30000
+#define FONT_HEADER_SIZE 23	/* U8G2_FONT_DATA_STRUCT_SIZE in u8g2_font.c */
+
+/* glyph decoder, see u8g2_font.c */
+int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data);
+
+static u8x8_display_info_t benchmark_display_info =
+{
+  /* chip_enable_level = */ 0,
+  /* chip_disable_level = */ 1,
+  /* post_chip_enable_wait_ns = */ 0,
+  /* pre_chip_disable_wait_ns = */ 0,
+  /* reset_pulse_width_ms = */ 0,
+  /* post_reset_wait_ms = */ 0,
+  /* sda_setup_time_ns = */ 0,
+  /* sck_pulse_width_ns = */ 0,
+  /* sck_clock_hz = */ 4000000UL,
+  /* spi_mode = */ 1,
+  /* i2c_bus_clock_100kHz = */ 0,
+  /* data_setup_time_ns = */ 0,
+  /* write_pulse_width_ns = */ 0,
+  /* tile_width = */ 32,
+  /* tile_height = */ 32,
+  /* default_x_offset = */ 0,
+  /* flipmode_x_offset = */ 0,
+  /* pixel_width = */ 256,
+  /* pixel_height = */ 256
+};
+
+static uint8_t benchmark_display_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_DISPLAY_SETUP_MEMORY )
+    u8x8_d_helper_display_setup_memory(u8x8, &benchmark_display_info);
+  return 1;
+}
+
+static uint8_t benchmark_dummy_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* replacement for the low level hvline procedure: measure the decoder without the buffer access */
+static void benchmark_ll_hvline_none(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+}
+
+static uint8_t font[MAX_FONT_SIZE];
+static const uint8_t *glyph_list[MAX_GLYPHS];
+static uint8_t buf[256*256/8];
+static u8g2_t u8g2;
+
+/* read the string literal of a font C source file, return the number of bytes */
+static long read_font(const char *filename)
+{
+  FILE *fp;
+  int c, i;
+  long len = 0;
+  int is_string = 0;
+  int is_data = 0;
+
+  fp = fopen(filename, "r");
+  if ( fp == NULL )
+    return 0;
+  while( (c = getc(fp)) != EOF && len < MAX_FONT_SIZE )
+  {
+    if ( is_data == 0 )
+    {
+      if ( c == '=' )
+	is_data = 1;
+      continue;
+    }
+    if ( is_string == 0 )
+    {
+      if ( c == ';' )
+	break;
+      if ( c == '\"' )
+	is_string = 1;
+      continue;
+    }
+    if ( c == '\"' )
+    {
+      is_string = 0;
+    }
+    else if ( c == '\\' )
+    {
+      c = getc(fp);
+      if ( c >= '0' && c <= '7' )
+      {
+	int v = 0;
+	for( i = 0; i < 3 && c >= '0' && c <= '7'; i++ )
+	{
+	  v = v*8 + c - '0';
+	  c = getc(fp);
+	}
+	ungetc(c, fp);
+	font[len++] = v;
+      }
+      else if ( c == 'n' )
+	font[len++] = '\n';
+      else if ( c == 't' )
+	font[len++] = '\t';
+      else if ( c == 'r' )
+	font[len++] = '\r';
+      else
+	font[len++] = c;
+    }
+    else
+    {
+      font[len++] = c;
+    }
+  }
+  fclose(fp);
+  if ( len < MAX_FONT_SIZE )
+    font[len++] = '\0';	/* terminating zero of the string literal, which is part of the font */
+  return len;
+}
+
+/* collect the glyph data of all glyphs, see u8g2_font_get_glyph_data() */
+static int get_glyph_list(const uint8_t *f)
+{
+  const uint8_t *p;
+  int cnt = 0;
+
+  p = f + FONT_HEADER_SIZE;
+  while( p[1] != 0 && cnt < MAX_GLYPHS )
+  {
+    glyph_list[cnt++] = p + 2;
+    p += p[1];
+  }
+
+  p = f + FONT_HEADER_SIZE;
+  p += (f[21] << 8) | f[22];
+  p += (p[0] << 8) | p[1];	/* skip the unicode lookup table */
+  while( (p[0] != 0 || p[1] != 0) && cnt < MAX_GLYPHS )
+  {
+    glyph_list[cnt++] = p + 3;
+    p += p[2];
+  }
+  return cnt;
+}
+
+/* decode the bit stream of the glyphs only, see u8g2_font_setup_decode() and u8g2_font_decode_glyph() */
+uint8_t u8g2_font_decode_get_unsigned_bits(u8g2_font_decode_t *f, uint8_t cnt);
+static unsigned long bit_sum;
+static clock_t read_glyph_bits(int glyph_cnt)
+{
+  u8g2_font_decode_t *f = &u8g2.font_decode;
+  const u8g2_font_info_t *fi = &u8g2.font_info;
+  int j, r;
+  unsigned pixel, size;
+  uint8_t a, b;
+  clock_t t = clock();
+  for( r = 0; r < REPEAT; r++ )
+  {
+    for( j = 0; j < glyph_cnt; j++ )
+    {
+      f->decode_ptr = glyph_list[j];
+      f->decode_bit_pos = 0;
+      size = u8g2_font_decode_get_unsigned_bits(f, fi->bits_per_char_width);
+      size *= u8g2_font_decode_get_unsigned_bits(f, fi->bits_per_char_height);
+      bit_sum += u8g2_font_decode_get_unsigned_bits(f, fi->bits_per_char_x);
+      bit_sum += u8g2_font_decode_get_unsigned_bits(f, fi->bits_per_char_y);
+      bit_sum += u8g2_font_decode_get_unsigned_bits(f, fi->bits_per_delta_x);
+      pixel = 0;
+      while( pixel < size )
+      {
+        a = u8g2_font_decode_get_unsigned_bits(f, fi->bits_per_0);
+        b = u8g2_font_decode_get_unsigned_bits(f, fi->bits_per_1);
+        do
+        {
+          pixel += a + b;
+        } while( u8g2_font_decode_get_unsigned_bits(f, 1) != 0 );
+      }
+      bit_sum += pixel;
+    }
+  }
+  return clock() - t;
+}
+
+static clock_t draw_glyphs(int glyph_cnt)
+{
+  int j, r;
+  clock_t t = clock();
+  for( r = 0; r < REPEAT; r++ )
+  {
+    for( j = 0; j < glyph_cnt; j++ )
+    {
+      u8g2.font_decode.target_x = 64 + (j & 63);
+      u8g2.font_decode.target_y = 128 + (j & 31);
+      u8g2_font_decode_glyph(&u8g2, glyph_list[j]);
+    }
+  }
+  return clock() - t;
+}
+
+int main(int argc, char **argv)
+{
+  int i, j, glyph_cnt;
+  long total_glyphs = 0;
+  int font_cnt = 0;
+  unsigned long checksum = 0;
+  clock_t bits_time = 0, decode_time = 0, draw_time = 0;
+
+  u8g2_SetupDisplay(&u8g2, benchmark_display_cb, u8x8_cad_empty, benchmark_dummy_cb, benchmark_dummy_cb);
+  u8g2_SetupBuffer(&u8g2, buf, 32, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+
+  for( i = 1; i < argc; i++ )
+  {
+    if ( strstr(argv[i], "u8g2_font_") == NULL )
+      continue;				/* u8x8 fonts have a different format */
+    if ( read_font(argv[i]) < FONT_HEADER_SIZE )
+      continue;
+
+    u8g2.font = NULL;			/* the font array is reused, force u8g2_SetFont() to read the new font info */
+    u8g2_SetFont(&u8g2, font);
+    u8g2_SetFontMode(&u8g2, 0);
+    glyph_cnt = get_glyph_list(font);
+
+    u8g2_ClearBuffer(&u8g2);
+    u8g2_SetDrawColor(&u8g2, 2);
+    
+    bits_time += read_glyph_bits(glyph_cnt);
+    u8g2.ll_hvline = benchmark_ll_hvline_none;
+    decode_time += draw_glyphs(glyph_cnt);
+    u8g2.ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
+    draw_time += draw_glyphs(glyph_cnt);
+
+    for( j = 0; j < (int)sizeof(buf); j++ )
+      checksum = checksum*33 + buf[j];
+    total_glyphs += glyph_cnt;
+    font_cnt++;
+  }
+
+  if ( total_glyphs == 0 )
+    total_glyphs = 1;
+  printf("%d fonts, %ld glyphs, bits %.1f ns/glyph, decode %.1f ns/glyph, decode and draw %.1f ns/glyph, checksum %08lx/%08lx\n",
+    font_cnt, total_glyphs, 
+    (double)bits_time*1e9/CLOCKS_PER_SEC/total_glyphs/REPEAT,
+    (double)decode_time*1e9/CLOCKS_PER_SEC/total_glyphs/REPEAT,
+    (double)draw_time*1e9/CLOCKS_PER_SEC/total_glyphs/REPEAT,
+    checksum & 0x0ffffffffUL, bit_sum & 0x0ffffffffUL);
+  return 0;
+}
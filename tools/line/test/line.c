@@ -0,0 +1,215 @@
+/*
+
+  line.c
+
+  Line test: u8g2_DrawLine() is compared with the pixel by pixel line
+  procedure of u8g2 v2.34 (line_old below).
+
+  make test
+
+  will build and run the test. Each random scene is drawn with the picture
+  loop into a frame, once with u8g2_DrawLine() and once with line_old().
+  Both frames must be identical. The scenes use all rotations, page and full
+  buffer mode, both buffer layouts, clip windows, draw colors and
+  coordinates outside of the display (also beyond the u8g2_int_t range).
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCENES 6000
+#define LINES_PER_SCENE 8
+
+/*===========================================*/
+/* u8g2_DrawLine() of u8g2 v2.34 */
+
+static void line_old(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2)
+{
+  u8g2_uint_t tmp;
+  u8g2_uint_t x,y;
+  u8g2_uint_t dx, dy;
+  u8g2_int_t err;
+  u8g2_int_t ystep;
+
+  uint8_t swapxy = 0;
+
+  /* no intersection check at the moment, should be added... */
+
+  if ( x1 > x2 ) dx = x1-x2; else dx = x2-x1;
+  if ( y1 > y2 ) dy = y1-y2; else dy = y2-y1;
+
+  if ( dy > dx )
+  {
+    swapxy = 1;
+    tmp = dx; dx =dy; dy = tmp;
+    tmp = x1; x1 =y1; y1 = tmp;
+    tmp = x2; x2 =y2; y2 = tmp;
+  }
+  if ( x1 > x2 )
+  {
+    tmp = x1; x1 =x2; x2 = tmp;
+    tmp = y1; y1 =y2; y2 = tmp;
+  }
+  err = dx >> 1;
+  if ( y2 > y1 ) ystep = 1; else ystep = -1;
+  y = y1;
+
+#ifndef  U8G2_16BIT
+  if ( x2 == 255 )
+    x2--;
+#else
+  if ( x2 == 0xffff )
+    x2--;
+#endif
+
+  for( x = x1; x <= x2; x++ )
+  {
+    if ( swapxy == 0 )
+      u8g2_DrawPixel(u8g2, x, y);
+    else
+      u8g2_DrawPixel(u8g2, y, x);
+    err -= (u8g2_uint_t)dy;
+    if ( err < 0 )
+    {
+      y += (u8g2_uint_t)ystep;
+      err += (u8g2_uint_t)dx;
+    }
+  }
+}
+
+/*===========================================*/
+/* scenes */
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+typedef void (*line_cb)(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2);
+
+static const setup_cb line_setup_list[] =
+{
+  u8g2_Setup_ssd1306_128x64_noname_1,
+  u8g2_Setup_ssd1306_128x64_noname_2,
+  u8g2_Setup_ssd1306_128x64_noname_f,
+  u8g2_Setup_st7920_s_128x64_1,		/* horizontal_right_lsb */
+  u8g2_Setup_st7920_s_128x64_f,
+  u8g2_Setup_sed1520_122x32_1,		/* width is not a multiple of 8 */
+};
+
+static const u8g2_cb_t *line_rotation_list[] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3, U8G2_MIRROR };
+
+#define CNT(a) (sizeof(a)/sizeof(*(a)))
+
+struct line_scene
+{
+  setup_cb setup;
+  const u8g2_cb_t *rotation;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+  uint8_t color[LINES_PER_SCENE];
+  u8g2_uint_t x1[LINES_PER_SCENE], y1[LINES_PER_SCENE], x2[LINES_PER_SCENE], y2[LINES_PER_SCENE];
+};
+
+static uint8_t frame_new[1024];
+static uint8_t frame_old[1024];
+
+static uint8_t line_dummy_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* a position around the display or any value of u8g2_uint_t */
+static u8g2_uint_t line_rand_pos(u8g2_uint_t size)
+{
+  if ( rand() % 8 == 0 )
+    return (u8g2_uint_t)rand();
+  return (u8g2_uint_t)(rand() % (size + 40) - 20);
+}
+
+static void line_rand_scene(struct line_scene *scene)
+{
+  static u8g2_t u8g2;
+  u8g2_uint_t w, h;
+  int i;
+
+  scene->setup = line_setup_list[rand() % CNT(line_setup_list)];
+  scene->rotation = line_rotation_list[rand() % CNT(line_rotation_list)];
+  scene->setup(&u8g2, scene->rotation, line_dummy_cb, line_dummy_cb);
+  w = u8g2_GetDisplayWidth(&u8g2);
+  h = u8g2_GetDisplayHeight(&u8g2);
+
+  /* clip windows must not be empty */
+  scene->is_clip = rand() % 2;
+  scene->clip_x0 = rand() % w;
+  scene->clip_x1 = scene->clip_x0 + 1 + rand() % (w - scene->clip_x0);
+  scene->clip_y0 = rand() % h;
+  scene->clip_y1 = scene->clip_y0 + 1 + rand() % (h - scene->clip_y0);
+
+  for( i = 0; i < LINES_PER_SCENE; i++ )
+  {
+    scene->color[i] = rand() % 3;
+    scene->x1[i] = line_rand_pos(w);
+    scene->y1[i] = line_rand_pos(h);
+    scene->x2[i] = line_rand_pos(w);
+    scene->y2[i] = line_rand_pos(h);
+    /* horizontal, vertical and diagonal lines */
+    if ( rand() % 8 == 0 )
+      scene->y2[i] = scene->y1[i];
+    if ( rand() % 8 == 0 )
+      scene->x2[i] = scene->x1[i];
+    if ( rand() % 8 == 0 )
+      scene->y2[i] = scene->y1[i] + (scene->x2[i] - scene->x1[i]);
+  }
+}
+
+/* draw the scene with the picture loop and collect the pages in frame */
+static void line_draw_scene(const struct line_scene *scene, line_cb line, uint8_t *frame)
+{
+  static u8g2_t u8g2;
+  size_t row_size, page_size, frame_size;
+  int i;
+
+  scene->setup(&u8g2, scene->rotation, line_dummy_cb, line_dummy_cb);
+  row_size = (size_t)u8g2_GetU8x8(&u8g2)->display_info->tile_width*8;
+  frame_size = row_size*u8g2_GetU8x8(&u8g2)->display_info->tile_height;
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    u8g2_SetDrawColor(&u8g2, 1);
+    u8g2_DrawBox(&u8g2, 10, 5, 40, 30);
+    if ( scene->is_clip )
+      u8g2_SetClipWindow(&u8g2, scene->clip_x0, scene->clip_y0, scene->clip_x1, scene->clip_y1);
+    for( i = 0; i < LINES_PER_SCENE; i++ )
+    {
+      u8g2_SetDrawColor(&u8g2, scene->color[i]);
+      line(&u8g2, scene->x1[i], scene->y1[i], scene->x2[i], scene->y2[i]);
+    }
+    u8g2_SetMaxClipWindow(&u8g2);
+    page_size = row_size*u8g2.tile_buf_height;
+    if ( page_size > frame_size - row_size*u8g2.tile_curr_row )
+      page_size = frame_size - row_size*u8g2.tile_curr_row;
+    memcpy(frame + row_size*u8g2.tile_curr_row, u8g2.tile_buf_ptr, page_size);
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+int main(void)
+{
+  struct line_scene scene;
+  int n, i;
+
+  for( n = 0; n < SCENES; n++ )
+  {
+    line_rand_scene(&scene);
+    line_draw_scene(&scene, u8g2_DrawLine, frame_new);
+    line_draw_scene(&scene, line_old, frame_old);
+    if ( memcmp(frame_new, frame_old, sizeof(frame_new)) != 0 )
+    {
+      printf("scene %d differs, clip %d: %d %d %d %d\n", n, scene.is_clip, scene.clip_x0, scene.clip_y0, scene.clip_x1, scene.clip_y1);
+      for( i = 0; i < LINES_PER_SCENE; i++ )
+	printf("  color %d: line %d %d %d %d\n", scene.color[i], scene.x1[i], scene.y1[i], scene.x2[i], scene.y2[i]);
+      return 1;
+    }
+  }
+  printf("%d scenes ok\n", SCENES);
+  return 0;
+}
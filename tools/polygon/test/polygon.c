@@ -0,0 +1,385 @@
+/*
+
+  polygon.c
+
+  Polygon test: u8g2_DrawPolygon() and u8g2_DrawTriangle() are compared
+  with the convex polygon procedure of u8g2 v2.34 (polygon_old.c) and with
+  a pixel by pixel reference (even-odd rule).
+
+  make test
+
+  will build and run the test. Each random scene is drawn with the picture
+  loop into a frame, once with the new procedures and once with the
+  reference. Both frames must be identical. The scenes use all rotations,
+  page and full buffer mode, both buffer layouts, clip windows, draw colors
+  and points outside of the display.
+
+  1. Convex polygons and triangles are compared with the old procedure.
+  2. Triangles with negative x, concave polygons with up to U8G2_PG_MAX_POINTS
+     points and polygons with up to MAX_POINTS points (u8g2_SetPolygonBuffer())
+     are compared with polygon_reference(). The old procedure can not draw
+     these polygons, it even stops with a division by zero (SIGFPE) for
+     horizontal edges inside concave polygons.
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCENES 4000
+#define POLYGONS_PER_SCENE 3
+#define MAX_POINTS 160
+
+/*===========================================*/
+/* polygon_old.c */
+
+void polygon_old_ClearPolygonXY(void);
+void polygon_old_AddPolygonXY(u8g2_t *u8g2, int16_t x, int16_t y);
+void polygon_old_DrawPolygon(u8g2_t *u8g2);
+void polygon_old_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+
+/*===========================================*/
+/* polygons */
+
+#define POLYGON_CONVEX 0
+#define POLYGON_TRIANGLE 1
+#define POLYGON_CONCAVE 2
+#define POLYGON_LARGE 3
+
+struct polygon
+{
+  uint8_t kind;
+  uint8_t color;
+  uint16_t cnt;
+  int16_t x[MAX_POINTS];
+  int16_t y[MAX_POINTS];
+};
+
+static uint8_t polygon_buf[U8G2_POLYGON_BUFFER_SIZE(MAX_POINTS)];
+
+static void polygon_new(u8g2_t *u8g2, const struct polygon *p)
+{
+  uint16_t i;
+
+  if ( p->kind == POLYGON_TRIANGLE )
+  {
+    u8g2_DrawTriangle(u8g2, p->x[0], p->y[0], p->x[1], p->y[1], p->x[2], p->y[2]);
+    return;
+  }
+  if ( p->kind == POLYGON_LARGE )
+    u8g2_SetPolygonBuffer(u8g2, polygon_buf, sizeof(polygon_buf));
+  u8g2_ClearPolygon(u8g2);
+  for( i = 0; i < p->cnt; i++ )
+    u8g2_AddPolygonXY(u8g2, p->x[i], p->y[i]);
+  u8g2_DrawPolygon(u8g2);
+  if ( p->kind == POLYGON_LARGE )
+    u8g2_SetPolygonBuffer(u8g2, NULL, 0);
+}
+
+/* only for convex polygons and triangles */
+static void polygon_old(u8g2_t *u8g2, const struct polygon *p)
+{
+  uint16_t i;
+
+  if ( p->kind == POLYGON_TRIANGLE )
+  {
+    polygon_old_DrawTriangle(u8g2, p->x[0], p->y[0], p->x[1], p->y[1], p->x[2], p->y[2]);
+    return;
+  }
+  polygon_old_ClearPolygonXY();
+  for( i = 0; i < p->cnt; i++ )
+    polygon_old_AddPolygonXY(u8g2, p->x[i], p->y[i]);
+  polygon_old_DrawPolygon(u8g2);
+}
+
+static int polygon_cmp_long(const void *a, const void *b)
+{
+  long x = *(const long *)a;
+  long y = *(const long *)b;
+  return x < y ? -1 : x > y;
+}
+
+/* x of the edge at scan line y: the old edge stepping rounds towards positive x */
+static long polygon_edge_x(long x1, long y1, long x2, long y2, long y)
+{
+  long n = (y - y1)*(x2 - x1);
+  long h = y2 - y1;
+  if ( n >= 0 )
+    return x1 + (n + h - 1)/h;
+  return x1 - (-n)/h;
+}
+
+/*
+  Pixel by pixel reference: An edge from (x1,y1) to (x2,y2) with y1 < y2
+  covers the scan lines y1 <= y < y2. The pixel x1 <= x < x2 between pairs
+  of sorted edges are set.
+*/
+static void polygon_reference(u8g2_t *u8g2, const struct polygon *p)
+{
+  static long xs[MAX_POINTS];
+  long w = u8g2_GetDisplayWidth(u8g2);
+  long h = u8g2_GetDisplayHeight(u8g2);
+  long x, y, x1, x2;
+  uint16_t i, j, n;
+
+  for( y = 0; y < h; y++ )
+  {
+    n = 0;
+    j = p->cnt - 1;
+    for( i = 0; i < p->cnt; i++ )
+    {
+      if ( p->y[j] < p->y[i] && p->y[j] <= y && y < p->y[i] )
+	xs[n++] = polygon_edge_x(p->x[j], p->y[j], p->x[i], p->y[i], y);
+      if ( p->y[i] < p->y[j] && p->y[i] <= y && y < p->y[j] )
+	xs[n++] = polygon_edge_x(p->x[i], p->y[i], p->x[j], p->y[j], y);
+      j = i;
+    }
+    qsort(xs, n, sizeof(long), polygon_cmp_long);
+    for( i = 1; i < n; i += 2 )
+    {
+      x1 = xs[i-1] < 0 ? 0 : xs[i-1];
+      x2 = xs[i] > w ? w : xs[i];
+      for( x = x1; x < x2; x++ )
+	u8g2_DrawPixel(u8g2, x, y);
+    }
+  }
+}
+
+/* a coordinate around the display, sometimes on a coarse grid for horizontal and vertical edges */
+static int16_t polygon_rand_pos(u8g2_uint_t size, uint8_t is_grid)
+{
+  if ( is_grid )
+    return (rand() % (size/8 + 12) - 6)*8;
+  if ( rand() % 16 == 0 )
+    return rand() % 4000 - 2000;
+  return rand() % (size + 80) - 40;
+}
+
+static long polygon_cross(const struct polygon *p, uint16_t a, uint16_t b, uint16_t c)
+{
+  return (long)(p->x[b] - p->x[a])*(p->y[c] - p->y[a]) - (long)(p->y[b] - p->y[a])*(p->x[c] - p->x[a]);
+}
+
+/* convex hull of the points (monotone chain), without collinear points */
+static void polygon_make_convex(struct polygon *p)
+{
+  static struct polygon sorted, hull;
+  uint16_t i, j, n, lower;
+  int16_t t;
+
+  sorted = *p;
+  for( i = 1; i < sorted.cnt; i++ )
+  {
+    for( j = i; j > 0 && (sorted.x[j-1] > sorted.x[j] || (sorted.x[j-1] == sorted.x[j] && sorted.y[j-1] > sorted.y[j])); j-- )
+    {
+      t = sorted.x[j]; sorted.x[j] = sorted.x[j-1]; sorted.x[j-1] = t;
+      t = sorted.y[j]; sorted.y[j] = sorted.y[j-1]; sorted.y[j-1] = t;
+    }
+  }
+  n = 0;
+  for( i = 0; i < sorted.cnt; i++ )
+  {
+    hull.x[n] = sorted.x[i];
+    hull.y[n] = sorted.y[i];
+    while( n >= 2 && polygon_cross(&hull, n-2, n-1, n) <= 0 )
+    {
+      hull.x[n-1] = hull.x[n];
+      hull.y[n-1] = hull.y[n];
+      n--;
+    }
+    n++;
+  }
+  lower = n;
+  for( i = sorted.cnt-1; i-- > 0; )
+  {
+    hull.x[n] = sorted.x[i];
+    hull.y[n] = sorted.y[i];
+    while( n > lower && polygon_cross(&hull, n-2, n-1, n) <= 0 )
+    {
+      hull.x[n-1] = hull.x[n];
+      hull.y[n-1] = hull.y[n];
+      n--;
+    }
+    n++;
+  }
+  n--;	/* the first point is also the last point */
+
+  /* random start point and orientation */
+  j = rand() % n;
+  for( i = 0; i < n; i++ )
+  {
+    p->x[i] = hull.x[(j+i) % n];
+    p->y[i] = hull.y[(j+i) % n];
+  }
+  if ( rand() % 2 )
+  {
+    for( i = 0; i < n/2; i++ )
+    {
+      t = p->x[i]; p->x[i] = p->x[n-1-i]; p->x[n-1-i] = t;
+      t = p->y[i]; p->y[i] = p->y[n-1-i]; p->y[n-1-i] = t;
+    }
+  }
+  p->cnt = n;
+}
+
+static void polygon_rand(struct polygon *p, u8g2_uint_t w, u8g2_uint_t h, uint8_t is_convex_only)
+{
+  uint8_t is_grid = rand() % 4 == 0;
+  uint16_t i;
+
+  p->kind = rand() % (is_convex_only ? 2 : 4);
+  p->color = rand() % 3;
+  switch(p->kind)
+  {
+    case POLYGON_TRIANGLE: p->cnt = 3; break;
+    case POLYGON_LARGE: p->cnt = U8G2_PG_MAX_POINTS + 1 + rand() % (MAX_POINTS - U8G2_PG_MAX_POINTS); break;
+    default: p->cnt = 3 + rand() % (U8G2_PG_MAX_POINTS - 2); break;
+  }
+  for(;;)
+  {
+    for( i = 0; i < p->cnt; i++ )
+    {
+      p->x[i] = polygon_rand_pos(w, is_grid);
+      p->y[i] = polygon_rand_pos(h, is_grid);
+    }
+    /* triangles across the left border */
+    if ( p->kind == POLYGON_TRIANGLE && rand() % 2 )
+      p->x[rand() % 3] = -1 - rand() % 60;
+    if ( p->kind != POLYGON_CONVEX )
+      return;
+    polygon_make_convex(p);
+    if ( p->cnt >= 3 )
+      return;
+    p->cnt = 3 + rand() % (U8G2_PG_MAX_POINTS - 2);
+  }
+}
+
+/*===========================================*/
+/* scenes */
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+typedef void (*polygon_cb)(u8g2_t *u8g2, const struct polygon *p);
+
+static const setup_cb polygon_setup_list[] =
+{
+  u8g2_Setup_ssd1306_128x64_noname_1,
+  u8g2_Setup_ssd1306_128x64_noname_2,
+  u8g2_Setup_ssd1306_128x64_noname_f,
+  u8g2_Setup_st7920_s_128x64_1,		/* horizontal_right_lsb */
+  u8g2_Setup_st7920_s_128x64_f,
+  u8g2_Setup_sed1520_122x32_1,		/* width is not a multiple of 8 */
+};
+
+static const u8g2_cb_t *polygon_rotation_list[] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3, U8G2_MIRROR };
+
+#define CNT(a) (sizeof(a)/sizeof(*(a)))
+
+struct polygon_scene
+{
+  setup_cb setup;
+  const u8g2_cb_t *rotation;
+  uint8_t is_clip;
+  u8g2_uint_t clip_x0, clip_y0, clip_x1, clip_y1;
+  struct polygon polygon[POLYGONS_PER_SCENE];
+};
+
+static uint8_t frame_new[1024];
+static uint8_t frame_ref[1024];
+
+static uint8_t polygon_dummy_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static void polygon_rand_scene(struct polygon_scene *scene, uint8_t is_convex_only)
+{
+  static u8g2_t u8g2;
+  u8g2_uint_t w, h;
+  int i;
+
+  scene->setup = polygon_setup_list[rand() % CNT(polygon_setup_list)];
+  scene->rotation = polygon_rotation_list[rand() % CNT(polygon_rotation_list)];
+  scene->setup(&u8g2, scene->rotation, polygon_dummy_cb, polygon_dummy_cb);
+  w = u8g2_GetDisplayWidth(&u8g2);
+  h = u8g2_GetDisplayHeight(&u8g2);
+
+  /* clip windows must not be empty */
+  scene->is_clip = rand() % 2;
+  scene->clip_x0 = rand() % w;
+  scene->clip_x1 = scene->clip_x0 + 1 + rand() % (w - scene->clip_x0);
+  scene->clip_y0 = rand() % h;
+  scene->clip_y1 = scene->clip_y0 + 1 + rand() % (h - scene->clip_y0);
+
+  for( i = 0; i < POLYGONS_PER_SCENE; i++ )
+    polygon_rand(scene->polygon+i, w, h, is_convex_only);
+}
+
+/* draw the scene with the picture loop and collect the pages in frame */
+static void polygon_draw_scene(const struct polygon_scene *scene, polygon_cb polygon, uint8_t *frame)
+{
+  static u8g2_t u8g2;
+  size_t row_size, page_size, frame_size;
+  int i;
+
+  /* smaller displays do not cover the complete frame */
+  memset(frame, 0, sizeof(frame_new));
+  scene->setup(&u8g2, scene->rotation, polygon_dummy_cb, polygon_dummy_cb);
+  row_size = (size_t)u8g2_GetU8x8(&u8g2)->display_info->tile_width*8;
+  frame_size = row_size*u8g2_GetU8x8(&u8g2)->display_info->tile_height;
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    u8g2_SetDrawColor(&u8g2, 1);
+    u8g2_DrawBox(&u8g2, 10, 5, 40, 30);
+    if ( scene->is_clip )
+      u8g2_SetClipWindow(&u8g2, scene->clip_x0, scene->clip_y0, scene->clip_x1, scene->clip_y1);
+    for( i = 0; i < POLYGONS_PER_SCENE; i++ )
+    {
+      u8g2_SetDrawColor(&u8g2, scene->polygon[i].color);
+      polygon(&u8g2, scene->polygon+i);
+    }
+    u8g2_SetMaxClipWindow(&u8g2);
+    page_size = row_size*u8g2.tile_buf_height;
+    if ( page_size > frame_size - row_size*u8g2.tile_curr_row )
+      page_size = frame_size - row_size*u8g2.tile_curr_row;
+    memcpy(frame + row_size*u8g2.tile_curr_row, u8g2.tile_buf_ptr, page_size);
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+static int polygon_test(const char *name, uint8_t is_convex_only, polygon_cb reference)
+{
+  static struct polygon_scene scene;
+  int n, i, j;
+
+  for( n = 0; n < SCENES; n++ )
+  {
+    polygon_rand_scene(&scene, is_convex_only);
+    polygon_draw_scene(&scene, polygon_new, frame_new);
+    polygon_draw_scene(&scene, reference, frame_ref);
+    if ( memcmp(frame_new, frame_ref, sizeof(frame_new)) != 0 )
+    {
+      printf("%s: scene %d differs, clip %d: %d %d %d %d\n", name, n, scene.is_clip, scene.clip_x0, scene.clip_y0, scene.clip_x1, scene.clip_y1);
+      for( i = 0; i < POLYGONS_PER_SCENE; i++ )
+      {
+	printf("  kind %d, color %d:", scene.polygon[i].kind, scene.polygon[i].color);
+	for( j = 0; j < scene.polygon[i].cnt; j++ )
+	  printf(" %d,%d", scene.polygon[i].x[j], scene.polygon[i].y[j]);
+	printf("\n");
+      }
+      return 1;
+    }
+  }
+  printf("%s: %d scenes ok\n", name, SCENES);
+  return 0;
+}
+
+int main(void)
+{
+  if ( polygon_test("old procedure", 1, polygon_old) )
+    return 1;
+  if ( polygon_test("reference", 0, polygon_reference) )
+    return 1;
+  return 0;
+}
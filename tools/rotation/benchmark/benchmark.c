@@ -0,0 +1,153 @@
+/*
+
+  benchmark.c
+
+  Display rotation benchmark: Draw a text page on a 128x64 display, which
+  is mounted in portrait orientation (U8G2_R1 and U8G2_R3).
+
+  make bench
+
+  will build and run the benchmark. Each rotation is measured with
+  u8g2_SetDisplayRotation() (rotation of each draw procedure) and with
+  u8g2_SetFlushRotation() (U8G2_R0 draw procedures, rotation of the
+  tiles during u8g2_SendBuffer()). The checksum of the display memory
+  must be identical for both modes.
+
+  Result (gcc -O2, x86-64, time per frame):
+    U8G2_R1                draw  35506 ns, send    424 ns, total  35930 ns
+    U8G2_R1 flush rotation draw  17025 ns, send   2144 ns, total  19169 ns
+    U8G2_R3                draw  34664 ns, send    428 ns, total  35092 ns
+    U8G2_R3 flush rotation draw  15562 ns, send   3182 ns, total  18745 ns
+  The flush rotation halves the draw time, but each u8g2_SendBuffer() has to
+  rotate all 128 tiles. Screens with only a few draw calls per frame are faster 
+  with u8g2_SetDisplayRotation(), also the flush rotation requires full buffer mode.
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* csrc does not contain the fonts, use the font from the single font files */
+#include "../../font/build/single_font_files/u8g2_font_6x10_tf.c"
+
+#define REPEAT 20000
+
+static u8x8_display_info_t benchmark_display_info =
+{
+  /* chip_enable_level = */ 0,
+  /* chip_disable_level = */ 1,
+  /* post_chip_enable_wait_ns = */ 0,
+  /* pre_chip_disable_wait_ns = */ 0,
+  /* reset_pulse_width_ms = */ 0,
+  /* post_reset_wait_ms = */ 0,
+  /* sda_setup_time_ns = */ 0,
+  /* sck_pulse_width_ns = */ 0,
+  /* sck_clock_hz = */ 4000000UL,
+  /* spi_mode = */ 0,
+  /* i2c_bus_clock_100kHz = */ 0,
+  /* data_setup_time_ns = */ 0,
+  /* write_pulse_width_ns = */ 0,
+  /* tile_width = */ 16,
+  /* tile_height = */ 8,
+  /* default_x_offset = */ 0,
+  /* flipmode_x_offset = */ 0,
+  /* pixel_width = */ 128,
+  /* pixel_height = */ 64
+};
+
+/* display memory: 8 tile rows with 128 bytes */
+static uint8_t display_ram[8][128];
+
+static uint8_t benchmark_display_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_tile_t *tile;
+  if ( msg == U8X8_MSG_DISPLAY_SETUP_MEMORY )
+  {
+    u8x8_d_helper_display_setup_memory(u8x8, &benchmark_display_info);
+  }
+  else if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE )
+  {
+    tile = (u8x8_tile_t *)arg_ptr;
+    memcpy(display_ram[tile->y_pos] + tile->x_pos*8, tile->tile_ptr, tile->cnt*8);
+  }
+  return 1;
+}
+
+static uint8_t benchmark_dummy_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t buf[128*64/8];
+static u8g2_t u8g2;
+
+/* a typical status screen in portrait orientation (64x128) */
+static void draw(void)
+{
+  u8g2_uint_t y;
+  u8g2_SetFont(&u8g2, u8g2_font_6x10_tf);
+  for( y = 10; y < 100; y += 10 )
+    u8g2_DrawStr(&u8g2, 1, y, "Value 12.3");
+  u8g2_DrawFrame(&u8g2, 0, 0, 64, 128);
+  u8g2_DrawHLine(&u8g2, 0, 101, 64);
+  u8g2_DrawBox(&u8g2, 4, 106, 40, 6);
+  u8g2_DrawLine(&u8g2, 4, 126, 60, 114);
+}
+
+static unsigned long get_checksum(void)
+{
+  unsigned long checksum = 0;
+  uint8_t *p = &(display_ram[0][0]);
+  size_t i;
+  for( i = 0; i < sizeof(display_ram); i++ )
+    checksum = checksum*33 + p[i];
+  return checksum & 0x0ffffffffUL;
+}
+
+static void measure(const char *name, const u8g2_cb_t *rotation, uint8_t is_flush_rotation)
+{
+  clock_t draw_time = 0, send_time = 0, t;
+  int r;
+
+  memset(display_ram, 0, sizeof(display_ram));
+  if ( is_flush_rotation )
+  {
+    if ( u8g2_SetFlushRotation(&u8g2, rotation) == 0 )
+      printf("%s: u8g2_SetFlushRotation failed\n", name);
+  }
+  else
+  {
+    u8g2_SetDisplayRotation(&u8g2, rotation);
+  }
+
+  for( r = 0; r < REPEAT; r++ )
+  {
+    t = clock();
+    u8g2_ClearBuffer(&u8g2);
+    draw();
+    draw_time += clock() - t;
+    t = clock();
+    u8g2_SendBuffer(&u8g2);
+    send_time += clock() - t;
+  }
+
+  printf("%-22s draw %6.0f ns, send %6.0f ns, total %6.0f ns, checksum %08lx\n", name,
+    (double)draw_time*1e9/CLOCKS_PER_SEC/REPEAT,
+    (double)send_time*1e9/CLOCKS_PER_SEC/REPEAT,
+    (double)(draw_time+send_time)*1e9/CLOCKS_PER_SEC/REPEAT,
+    get_checksum());
+}
+
+int main(void)
+{
+  u8g2_SetupDisplay(&u8g2, benchmark_display_cb, u8x8_cad_empty, benchmark_dummy_cb, benchmark_dummy_cb);
+  u8g2_SetupBuffer(&u8g2, buf, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+
+  measure("U8G2_R1", U8G2_R1, 0);
+  measure("U8G2_R1 flush rotation", U8G2_R1, 1);
+  measure("U8G2_R3", U8G2_R3, 0);
+  measure("U8G2_R3 flush rotation", U8G2_R3, 1);
+  return 0;
+}
@@ -0,0 +1,183 @@
+/*
+
+  shadow.c
+
+  Shadow buffer test: The byte procedure decodes the ssd1306 commands and
+  data and keeps a copy of the display RAM. It also records, which tiles
+  have been sent.
+
+  make test
+
+  will build and run the test. For each frame, the set of sent tiles must
+  be the set of tiles, which differ from the previous frame, and the 
+  display RAM must be equal to the tile buffer. The test is done for
+  u8g2_SendBuffer() (full buffer) and for the picture loop (page buffer).
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* csrc does not contain the fonts, use the font from the single font files */
+#include "../../font/build/single_font_files/u8g2_font_6x10_tf.c"
+
+#define FRAMES 500
+#define TILE_WIDTH 16
+#define TILE_HEIGHT 8
+
+static uint8_t display_ram[TILE_HEIGHT][TILE_WIDTH*8];
+static uint8_t is_tile_sent[TILE_HEIGHT][TILE_WIDTH];
+static int column, page, is_data;
+static long sent_tile_cnt;
+
+/* decode the ssd1306 page addressing mode commands, see u8x8_d_ssd1306_128x64_noname_draw_tile */
+static uint8_t shadow_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *data = (uint8_t *)arg_ptr;
+  uint8_t b;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      while( arg_int > 0 )
+      {
+	b = *data++;
+	arg_int--;
+	if ( is_data )
+	{
+	  if ( column < TILE_WIDTH*8 && page < TILE_HEIGHT )
+	  {
+	    display_ram[page][column] = b;
+	    if ( is_tile_sent[page][column/8] == 0 )
+	      sent_tile_cnt++;
+	    is_tile_sent[page][column/8] = 1;
+	  }
+	  column++;
+	}
+	else if ( b < 0x10 )
+	  column = (column & 0xf0) | b;
+	else if ( b < 0x20 )
+	  column = (column & 0x0f) | ((b & 0x0f) << 4);
+	else if ( b >= 0xb0 && b < 0xb8 )
+	  page = b & 7;
+      }
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      is_data = arg_int;
+      break;
+  }
+  return 1;
+}
+
+static uint8_t shadow_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static void shadow_draw(u8g2_t *u8g2, int frame)
+{
+  char s[16];
+  
+  srand(frame);
+  u8g2_SetFont(u8g2, u8g2_font_6x10_tf);
+  snprintf(s, sizeof(s), "%d", frame/10);
+  u8g2_DrawStr(u8g2, 0, 10, s);
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  /* frames with the same value of frame/4 are equal, no tile must be sent */
+  if ( (frame/4) % 3 == 0 )
+    u8g2_DrawBox(u8g2, rand() % 120, 12 + rand() % 40, rand() % 9 + 1, rand() % 12 + 1);
+  if ( (frame/4) % 5 == 0 )
+    u8g2_DrawPixel(u8g2, rand() % 128, rand() % 64);
+  if ( (frame/4) % 7 == 0 )
+    u8g2_DrawLine(u8g2, rand() % 128, rand() % 64, rand() % 128, rand() % 64);
+}
+
+/* full frame of the previous and the current transfer */
+static uint8_t prev_frame[TILE_HEIGHT*TILE_WIDTH*8];
+static uint8_t curr_frame[TILE_HEIGHT*TILE_WIDTH*8];
+
+static int shadow_check(const char *name, int frame, int is_first)
+{
+  int tx, ty;
+  int is_changed;
+  
+  if ( memcmp(display_ram, curr_frame, sizeof(curr_frame)) != 0 )
+  {
+    printf("%s frame %d: display RAM differs from the tile buffer\n", name, frame);
+    return 1;
+  }
+  for( ty = 0; ty < TILE_HEIGHT; ty++ )
+  {
+    for( tx = 0; tx < TILE_WIDTH; tx++ )
+    {
+      is_changed = is_first || memcmp(prev_frame+(ty*TILE_WIDTH+tx)*8, curr_frame+(ty*TILE_WIDTH+tx)*8, 8) != 0;
+      if ( is_changed != is_tile_sent[ty][tx] )
+      {
+	printf("%s frame %d: tile %d/%d %s\n", name, frame, tx, ty, is_changed ? "not sent" : "sent without change");
+	return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+static int shadow_test(const char *name, void (*setup)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb))
+{
+  static uint8_t shadow_buf[TILE_HEIGHT*TILE_WIDTH*8];
+  u8g2_t u8g2;
+  int frame;
+  uint8_t tile_row;
+  
+  setup(&u8g2, U8G2_R0, shadow_byte_cb, shadow_gpio_and_delay_cb);
+  if ( u8g2_GetShadowBufferSize(&u8g2) != sizeof(shadow_buf) )
+  {
+    printf("%s: wrong shadow buffer size\n", name);
+    return 1;
+  }
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8g2_SetShadowBuffer(&u8g2, shadow_buf);
+  sent_tile_cnt = 0;
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    memset(is_tile_sent, 0, sizeof(is_tile_sent));
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      shadow_draw(&u8g2, frame);
+      /* keep a copy of the complete frame */
+      tile_row = u8g2.tile_curr_row;
+      memcpy(curr_frame + tile_row*TILE_WIDTH*8, u8g2.tile_buf_ptr, (size_t)u8g2.tile_buf_height*TILE_WIDTH*8);
+    } while( u8g2_NextPage(&u8g2) );
+    if ( shadow_check(name, frame, frame == 0) )
+      return 1;
+    memcpy(prev_frame, curr_frame, sizeof(curr_frame));
+  }
+  
+  /* invalidated shadow buffer: all tiles are sent */
+  memset(is_tile_sent, 0, sizeof(is_tile_sent));
+  u8g2_InvalidateShadowBuffer(&u8g2);
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    shadow_draw(&u8g2, frame-1);
+  } while( u8g2_NextPage(&u8g2) );
+  if ( shadow_check(name, frame, 1) )
+    return 1;
+  
+  printf("%s: %ld of %d tiles sent\n", name, sent_tile_cnt, FRAMES*TILE_HEIGHT*TILE_WIDTH);
+  return 0;
+}
+
+int main(void)
+{
+  int err = 0;
+  err |= shadow_test("full buffer", u8g2_Setup_ssd1306_128x64_noname_f);
+  err |= shadow_test("page buffer 1", u8g2_Setup_ssd1306_128x64_noname_1);
+  err |= shadow_test("page buffer 2", u8g2_Setup_ssd1306_128x64_noname_2);
+  if ( err )
+    return 1;
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,199 @@
+/*
+
+  surface.c
+
+  Bit block transfer test: u8g2_BitBlt() is compared with a copy, which
+  reads each pixel of the source and writes it with u8g2_DrawPixel() into
+  the destination.
+
+  make test
+
+  will build the test with -fsanitize=address,undefined and run it. The
+  destination is a full buffer display with vertical or horizontal byte
+  layout, with and without u8g2_SetFlushRotation(). The source is a
+  surface with the same or the other byte layout or the destination
+  itself (overlapping rectangles). All raster operations are tested with
+  random rectangles, which may exceed source and destination.
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CASES 4000
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+struct surface_display
+{
+  const char *name;
+  setup_cb setup;
+  const u8g2_cb_t *flush_rotation;	/* NULL: U8G2_R0 */
+};
+
+static const struct surface_display surface_display_list[] =
+{
+  { "ssd1306_128x64_noname", u8g2_Setup_ssd1306_128x64_noname_f, NULL },
+  { "ssd1306_128x64_noname flush R1", u8g2_Setup_ssd1306_128x64_noname_f, U8G2_R1 },
+  { "ssd1306_128x64_noname flush R3", u8g2_Setup_ssd1306_128x64_noname_f, U8G2_R3 },
+  /* horizontal_right_lsb */
+  { "st7920_s_128x64", u8g2_Setup_st7920_s_128x64_f, NULL },
+  /* the width is not a multiple of 8 */
+  { "sed1520_122x32", u8g2_Setup_sed1520_122x32_f, NULL },
+};
+
+#define DISPLAY_CNT (sizeof(surface_display_list)/sizeof(*surface_display_list))
+
+static uint8_t vertical_buf[U8G2_SURFACE_BUFFER_SIZE(64, 128)];
+static uint8_t horizontal_buf[U8G2_SURFACE_BUFFER_SIZE(64, 128)];
+static uint8_t dst_copy[U8G2_SURFACE_BUFFER_SIZE(128, 128)];
+static uint8_t src_copy[U8G2_SURFACE_BUFFER_SIZE(128, 128)];
+
+static uint8_t surface_dummy_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* size of the tile buffer in bytes (full buffer mode) */
+static size_t surface_get_size(u8g2_t *u8g2)
+{
+  return (size_t)u8g2->pixel_buf_width * u8g2->pixel_buf_height / 8;
+}
+
+/* read a pixel from a copy of the tile buffer of u8g2 */
+static uint8_t surface_get_pixel(u8g2_t *u8g2, const uint8_t *buf, uint16_t x, uint16_t y)
+{
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+    return (buf[(y/8)*u8g2->pixel_buf_width + x] >> (y&7)) & 1;
+  return (buf[y*(u8g2->pixel_buf_width/8) + x/8] >> (7-(x&7))) & 1;
+}
+
+static void surface_fill(u8g2_t *u8g2)
+{
+  size_t i, n = surface_get_size(u8g2);
+  for( i = 0; i < n; i++ )
+    u8g2->tile_buf_ptr[i] = rand();
+}
+
+static uint16_t surface_rand(uint16_t n)
+{
+  return rand() % (n+1);
+}
+
+static int surface_check(const char *name, int n, u8g2_t *dst, uint16_t dx, uint16_t dy, u8g2_t *src, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h, uint8_t rop)
+{
+  size_t size = surface_get_size(dst);
+  uint16_t dst_w = u8g2_GetDisplayWidth(dst);
+  uint16_t dst_h = u8g2_GetDisplayHeight(dst);
+  uint16_t src_w = u8g2_GetDisplayWidth(src);
+  uint16_t src_h = u8g2_GetDisplayHeight(src);
+  uint16_t i, j;
+  uint8_t d, s;
+
+  memcpy(dst_copy, dst->tile_buf_ptr, size);
+  memcpy(src_copy, src->tile_buf_ptr, surface_get_size(src));
+
+  /* reference: the draw procedures use the same pixel positions as u8g2_BitBlt() with U8G2_R0 and the flush rotation */
+  for( j = 0; j < h; j++ )
+  {
+    for( i = 0; i < w; i++ )
+    {
+      if ( dx+i >= dst_w || dy+j >= dst_h || sx+i >= src_w || sy+j >= src_h )
+	continue;
+      d = surface_get_pixel(dst, dst_copy, dx+i, dy+j);
+      s = surface_get_pixel(src, src_copy, sx+i, sy+j);
+      switch(rop)
+      {
+	case U8G2_ROP_COPY: d = s; break;
+	case U8G2_ROP_OR: d |= s; break;
+	case U8G2_ROP_AND: d &= s; break;
+	case U8G2_ROP_XOR: d ^= s; break;
+	case U8G2_ROP_NOT: d = s ^ 1; break;
+      }
+      u8g2_SetDrawColor(dst, d);
+      u8g2_DrawPixel(dst, dx+i, dy+j);
+    }
+  }
+
+  /* exchange the reference and the original content */
+  for( i = 0; i < size; i++ )
+  {
+    d = dst->tile_buf_ptr[i];
+    dst->tile_buf_ptr[i] = dst_copy[i];
+    dst_copy[i] = d;
+  }
+
+  u8g2_BitBlt(dst, dx, dy, src, sx, sy, w, h, rop);
+  if ( memcmp(dst->tile_buf_ptr, dst_copy, size) != 0 )
+  {
+    printf("%s case %d: BitBlt(%d, %d, %s %dx%d, %d, %d, %d, %d, rop %d) differs from the pixel copy\n",
+      name, n, dx, dy, src == dst ? "dst" : "surface", src_w, src_h, sx, sy, w, h, rop);
+    return 1;
+  }
+  return 0;
+}
+
+static int surface_test(const struct surface_display *display)
+{
+  static u8g2_t vertical, horizontal;
+  u8g2_t u8g2;
+  u8g2_t *src;
+  uint16_t dst_w, dst_h;
+  int n;
+
+  display->setup(&u8g2, U8G2_R0, surface_dummy_cb, surface_dummy_cb);
+  if ( display->flush_rotation != NULL )
+  {
+    if ( u8g2_SetFlushRotation(&u8g2, display->flush_rotation) == 0 )
+    {
+      printf("%s: u8g2_SetFlushRotation() failed\n", display->name);
+      return 1;
+    }
+  }
+  dst_w = u8g2_GetDisplayWidth(&u8g2);
+  dst_h = u8g2_GetDisplayHeight(&u8g2);
+
+  /* the complete buffer: 64x128 for the flush rotation, 64x64 otherwise */
+  u8g2_SetupSurface(&vertical, vertical_buf, 64, dst_h > 64 ? 128 : 64, u8g2_ll_hvline_vertical_top_lsb);
+  surface_fill(&vertical);
+  surface_fill(&u8g2);
+  if ( surface_check(display->name, 0, &u8g2, 0, 0, &vertical, 0, 0, 64, 128, U8G2_ROP_COPY) )
+    return 1;
+
+  for( n = 1; n < CASES; n++ )
+  {
+    u8g2_SetupSurface(&vertical, vertical_buf, 1+rand()%64, 1+rand()%128, u8g2_ll_hvline_vertical_top_lsb);
+    u8g2_SetupSurface(&horizontal, horizontal_buf, 1+rand()%64, 1+rand()%128, u8g2_ll_hvline_horizontal_right_lsb);
+    surface_fill(&vertical);
+    surface_fill(&horizontal);
+    surface_fill(&u8g2);
+    switch(rand()%3)
+    {
+      case 0: src = &vertical; break;
+      case 1: src = &horizontal; break;
+      default: src = &u8g2; break;
+    }
+    if ( surface_check(display->name, n, &u8g2,
+	surface_rand(dst_w), surface_rand(dst_h),
+	src, surface_rand(u8g2_GetDisplayWidth(src)), surface_rand(u8g2_GetDisplayHeight(src)),
+	surface_rand(dst_w+8), surface_rand(dst_h+8), rand() % (U8G2_ROP_NOT+1)) )
+      return 1;
+  }
+  printf("%s: %d cases ok\n", display->name, CASES);
+  return 0;
+}
+
+int main(void)
+{
+  size_t i;
+  int err = 0;
+
+  for( i = 0; i < DISPLAY_CNT; i++ )
+    err |= surface_test(surface_display_list+i);
+  if ( err )
+    return 1;
+  printf("ok\n");
+  return 0;
+}
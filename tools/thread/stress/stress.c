@@ -0,0 +1,236 @@
+/*
+
+  stress.c
+
+  Multi display stress test: Several u8g2 instances with different
+  display, cad and byte procedures are drawn and sent from several
+  threads at the same time. The byte procedures only calculate a checksum
+  of the data, which would be sent to the display.
+
+  make test
+
+  will build the test with -fsanitize=thread and run it. The test fails, if
+  ThreadSanitizer reports a data race or if the checksum of a thread
+  differs from the checksum of the same display without other threads.
+
+  Each instance has its own tile buffer (U8G2_USE_DYNAMIC_ALLOC), polygon 
+  buffer, font index and glyph cache. The static buffers of 
+  u8g2_d_memory.c are not used.
+
+*/
+
+#include "u8g2.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* csrc does not contain the fonts, use the font from the single font files */
+#include "../../font/build/single_font_files/u8g2_font_6x10_tf.c"
+
+#define FRAMES 40
+#define THREADS_PER_DISPLAY 3
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+struct stress_display
+{
+  const char *name;
+  setup_cb setup;
+  u8x8_msg_cb byte_cb;		/* NULL: stress_byte_cb */
+};
+
+/* one u8g2 instance, u8g2 must be the first member (see stress_get_instance) */
+struct stress_instance
+{
+  u8g2_t u8g2;
+  const struct stress_display *display;
+  uint32_t checksum;
+  uint8_t *buf;
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+  uint8_t pg_buf[U8G2_POLYGON_BUFFER_SIZE(32)];
+#endif
+#ifdef U8G2_WITH_FONT_INDEX
+  uint32_t font_index[U8G2_FONT_INDEX_SIZE(0)];
+#endif
+#ifdef U8G2_WITH_GLYPH_CACHE
+  uint8_t glyph_cache[2048];
+#endif
+  pthread_t thread;
+};
+
+static const struct stress_display stress_display_list[] =
+{
+  /* ssd13xx fast i2c cad */
+  { "ssd1306_i2c_128x64_noname", u8g2_Setup_ssd1306_i2c_128x64_noname_f, NULL },
+  /* 3-wire sw spi byte procedure */
+  { "ssd1306_128x64_noname 3wire", u8g2_Setup_ssd1306_128x64_noname_f, u8x8_byte_3wire_sw_spi },
+  /* grayscale tile conversion */
+  { "ssd1322_nhd_256x64", u8g2_Setup_ssd1322_nhd_256x64_f, NULL },
+  { "ssd1327_i2c_ws_128x128", u8g2_Setup_ssd1327_i2c_ws_128x128_f, NULL },
+  /* uc16xx i2c cad */
+  { "uc1601_i2c_128x32", u8g2_Setup_uc1601_i2c_128x32_f, NULL },
+  /* st7920 cad buffer */
+  { "st7920_s_128x64", u8g2_Setup_st7920_s_128x64_f, NULL },
+  /* sed1520 byte procedure */
+  { "sed1520_122x32", u8g2_Setup_sed1520_122x32_f, u8x8_byte_sed1520 },
+};
+
+#define DISPLAY_CNT (sizeof(stress_display_list)/sizeof(*stress_display_list))
+
+static struct stress_instance *stress_get_instance(u8x8_t *u8x8)
+{
+  return (struct stress_instance *)u8x8;
+}
+
+static void stress_add(u8x8_t *u8x8, uint8_t b)
+{
+  struct stress_instance *instance = stress_get_instance(u8x8);
+  instance->checksum = (instance->checksum ^ b) * 16777619UL;
+}
+
+static uint8_t stress_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *data = (uint8_t *)arg_ptr;
+  stress_add(u8x8, msg);
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      while( arg_int > 0 )
+      {
+	stress_add(u8x8, *data++);
+	arg_int--;
+      }
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      stress_add(u8x8, arg_int);
+      break;
+  }
+  return 1;
+}
+
+/* the pin changes of the byte procedures u8x8_byte_3wire_sw_spi and u8x8_byte_sed1520 */
+static uint8_t stress_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg >= U8X8_MSG_GPIO_D0 )
+  {
+    stress_add(u8x8, msg);
+    stress_add(u8x8, arg_int);
+  }
+  return 1;
+}
+
+static void stress_draw(u8g2_t *u8g2, int frame)
+{
+  u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+  u8g2_uint_t h = u8g2_GetDisplayHeight(u8g2);
+  char s[16];
+  
+  u8g2_SetDrawColor(u8g2, 1);
+  u8g2_SetFont(u8g2, u8g2_font_6x10_tf);
+  snprintf(s, sizeof(s), "Frame %d", frame);
+  u8g2_DrawStr(u8g2, frame % 8, 10, s);
+  u8g2_DrawUTF8(u8g2, 0, h-2, "\xc2\xb5s \xc2\xb0""C");
+  
+  u8g2_DrawFrame(u8g2, 0, 0, w, h);
+  u8g2_DrawBox(u8g2, (frame*3) % (w-10), h/2, 10, 5);
+  u8g2_DrawLine(u8g2, 0, frame % h, w-1, h-1-frame % h);
+  u8g2_DrawCircle(u8g2, w/2, h/2, h/4, U8G2_DRAW_ALL);
+  u8g2_DrawDisc(u8g2, w/4, h/2, h/8, U8G2_DRAW_ALL);
+  
+  /* concave polygon */
+  u8g2_ClearPolygon(u8g2);
+  u8g2_AddPolygonXY(u8g2, w-40, 2);
+  u8g2_AddPolygonXY(u8g2, w-2, 2+frame%8);
+  u8g2_AddPolygonXY(u8g2, w-20, h/4);
+  u8g2_AddPolygonXY(u8g2, w-2, h-2);
+  u8g2_AddPolygonXY(u8g2, w-40, h-2);
+  u8g2_DrawPolygon(u8g2);
+  u8g2_DrawTriangle(u8g2, 20, 2, 40, h/2, 2, h/2+frame%4);
+  
+  u8g2_SetDrawColor(u8g2, 2);
+  u8g2_DrawBox(u8g2, 2, 2, w/3, h/3);
+}
+
+static void stress_setup(struct stress_instance *instance, const struct stress_display *display)
+{
+  u8g2_t *u8g2 = &(instance->u8g2);
+  
+  instance->display = display;
+  instance->checksum = 2166136261UL;
+  display->setup(u8g2, U8G2_R0, display->byte_cb != NULL ? display->byte_cb : stress_byte_cb, stress_gpio_and_delay_cb);
+  instance->buf = (uint8_t *)malloc(u8g2_GetBufferSize(u8g2));
+  u8g2_SetBufferPtr(u8g2, instance->buf);
+#ifdef U8G2_WITH_POLYGON_EDGE_TABLE
+  u8g2_SetPolygonBuffer(u8g2, instance->pg_buf, sizeof(instance->pg_buf));
+#endif
+#ifdef U8G2_WITH_FONT_INDEX
+  u8g2_SetFontIndexBuffer(u8g2, instance->font_index, sizeof(instance->font_index)/sizeof(uint32_t));
+#endif
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2_SetGlyphCache(u8g2, instance->glyph_cache, sizeof(instance->glyph_cache));
+#endif
+}
+
+static void *stress_thread(void *arg)
+{
+  struct stress_instance *instance = (struct stress_instance *)arg;
+  u8g2_t *u8g2 = &(instance->u8g2);
+  int frame;
+  
+  u8g2_InitDisplay(u8g2);
+  u8g2_SetPowerSave(u8g2, 0);
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_ClearBuffer(u8g2);
+    stress_draw(u8g2, frame);
+    u8g2_SendBuffer(u8g2);
+    u8g2_SetContrast(u8g2, frame);
+  }
+  return NULL;
+}
+
+int main(void)
+{
+  static struct stress_instance reference[DISPLAY_CNT];
+  static struct stress_instance instance[DISPLAY_CNT*THREADS_PER_DISPLAY];
+  size_t i;
+  int err = 0;
+  
+  /* checksum of each display without other threads */
+  for( i = 0; i < DISPLAY_CNT; i++ )
+  {
+    stress_setup(reference+i, stress_display_list+i);
+    stress_thread(reference+i);
+  }
+  
+  for( i = 0; i < DISPLAY_CNT*THREADS_PER_DISPLAY; i++ )
+    stress_setup(instance+i, stress_display_list+i%DISPLAY_CNT);
+  for( i = 0; i < DISPLAY_CNT*THREADS_PER_DISPLAY; i++ )
+  {
+    if ( pthread_create(&(instance[i].thread), NULL, stress_thread, instance+i) != 0 )
+    {
+      perror("pthread_create");
+      return 1;
+    }
+  }
+  for( i = 0; i < DISPLAY_CNT*THREADS_PER_DISPLAY; i++ )
+    pthread_join(instance[i].thread, NULL);
+  
+  for( i = 0; i < DISPLAY_CNT*THREADS_PER_DISPLAY; i++ )
+  {
+    if ( instance[i].checksum != reference[i%DISPLAY_CNT].checksum )
+    {
+      printf("%s: checksum %08lx, expected %08lx\n", instance[i].display->name,
+	(unsigned long)instance[i].checksum, (unsigned long)reference[i%DISPLAY_CNT].checksum);
+      err = 1;
+    }
+  }
+  printf("%d displays, %d threads, %d frames: %s\n", (int)DISPLAY_CNT, (int)(DISPLAY_CNT*THREADS_PER_DISPLAY), FRAMES, err ? "failed" : "ok");
+  
+  for( i = 0; i < DISPLAY_CNT; i++ )
+    free(reference[i].buf);
+  for( i = 0; i < DISPLAY_CNT*THREADS_PER_DISPLAY; i++ )
+    free(instance[i].buf);
+  return err;
+}